@@ -0,0 +1,79 @@
+#!/bin/sh
+#
+# bench.sh - runs stcpp over every workload of a generated corpus
+#
+# usage: bench.sh stcpp corpusdir [runs]
+#
+# Each workload (a subdirectory of corpusdir with a main.c) is preprocessed
+# runs times (default 5). The median wall time is reported together with
+# the throughput in MB/s and lines/s. Bytes and lines are the sizes of all
+# files of the workload, headers included multiple times are counted once.
+#
+# Before a workload is timed, the output of stcpp is compared with the one
+# of $CC -E -P (default gcc), split into tokens, so whitespace and line
+# breaks do not count. A workload with a different output fails the bench.
+#
+
+STCPP=$1
+CORPUS=$2
+RUNS=${3:-5}
+
+if [ -z "$STCPP" ] || [ -z "$CORPUS" ]; then
+  echo "usage:" >&2
+  echo "bench.sh stcpp corpusdir [runs]" >&2
+  exit 1
+fi
+
+CC=${CC:-gcc}
+OUT=${BENCH_OUT:-/tmp/stcpp_bench.$$}
+REF=/tmp/stcpp_bench_ref.$$
+trap 'rm -f "$OUT" "$REF" "$OUT.tok" "$REF.tok"' EXIT
+
+now() {
+  date +%s%N
+}
+
+tokens() {
+  grep -oE '[A-Za-z_][A-Za-z_0-9]*|[0-9.][A-Za-z0-9_.]*|"([^"\\]|\\.)*"|'"'"'([^'"'"'\\]|\\.)*'"'"'|<<=|>>=|->|\+\+|--|<<|>>|<=|>=|==|!=|&&|\|\||\.\.\.|##|[^[:space:]]' "$1"
+}
+
+printf "%-16s %10s %8s %10s %9s %11s\n" workload bytes lines median_ms MB/s lines/s
+
+for dir in "$CORPUS"/*/; do
+  name=$(basename "$dir")
+  [ -f "$dir/main.c" ] || continue
+  bytes=$(cat "$dir"/* | wc -c)
+  lines=$(cat "$dir"/* | wc -l)
+
+  if ! "$STCPP" -I"$dir" "$dir/main.c" "$OUT" > /dev/null 2>&1 \
+     || ! $CC -E -P -fmax-include-depth=1000 -I"$dir" "$dir/main.c" -o "$REF" 2> /dev/null; then
+    echo "$name: preprocessing failed" >&2
+    exit 1
+  fi
+  tokens "$OUT" > "$OUT.tok"
+  tokens "$REF" > "$REF.tok"
+  if ! cmp -s "$OUT.tok" "$REF.tok"; then
+    echo "$name: output differs from $CC -E" >&2
+    exit 1
+  fi
+
+  times=""
+  i=0
+  while [ $i -lt "$RUNS" ]; do
+    start=$(now)
+    if ! "$STCPP" -I"$dir" "$dir/main.c" "$OUT" > /dev/null 2>&1; then
+      echo "$name: stcpp failed" >&2
+      exit 1
+    fi
+    end=$(now)
+    times="$times $((end - start))"
+    i=$((i + 1))
+  done
+
+  median=$(echo $times | tr ' ' '\n' | sort -n | awk '{ t[NR] = $1 } END { print (NR % 2) ? t[(NR + 1) / 2] : (t[NR / 2] + t[NR / 2 + 1]) / 2 }')
+  awk -v n="$name" -v b="$bytes" -v l="$lines" -v t="$median" 'BEGIN {
+    s = t / 1e9
+    if (s <= 0) s = 1e-9
+    printf "%-16s %10d %8d %10.2f %9.2f %11.0f\n", n, b, l, t / 1e6, b / s / 1e6, l / s
+  }'
+done
@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+# compare.sh - compares the throughput of several stcpp builds
+#
+# usage: compare.sh corpusdir runs name=stcpp...
+#
+# Runs bench.sh with every build over the workloads of corpusdir and prints
+# the throughput in MB/s per workload and build. The last line gives the
+# total time of each build relative to the first one.
+#
+
+CORPUS=$1
+RUNS=$2
+shift 2
+
+if [ -z "$CORPUS" ] || [ -z "$RUNS" ] || [ $# -eq 0 ]; then
+  echo "usage:" >&2
+  echo "compare.sh corpusdir runs name=stcpp..." >&2
+  exit 1
+fi
+
+BENCH=$(dirname "$0")/bench.sh
+TMP=$(mktemp -d /tmp/stcpp_compare.XXXXXX)
+trap 'rm -rf "$TMP"' EXIT
+
+names=""
+for variant in "$@"; do
+  name=${variant%%=*}
+  stcpp=${variant#*=}
+  if ! "$BENCH" "$stcpp" "$CORPUS" "$RUNS" > "$TMP/$name"; then
+    echo "$name: benchmark failed" >&2
+    exit 1
+  fi
+  names="$names $name"
+done
+
+# bench.sh columns: workload bytes lines median_ms MB/s lines/s
+cd "$TMP" && awk -v names="$names" '
+  BEGIN {
+    n = split(names, variant, " ")
+    printf "%-16s", "MB/s"
+    for (v = 1; v <= n; v++) printf " %10s", variant[v]
+    printf "\n"
+  }
+  FNR == 1 { file++; next }
+  {
+    if (file == 1) workload[++rows] = $1
+    mbs[$1, file] = $5
+    ms[file] += $4
+  }
+  END {
+    for (r = 1; r <= rows; r++) {
+      printf "%-16s", workload[r]
+      for (v = 1; v <= n; v++) printf " %10.2f", mbs[workload[r], v]
+      printf "\n"
+    }
+    printf "%-16s", "speedup"
+    for (v = 1; v <= n; v++) printf " %9.2fx", (ms[v] > 0 ? ms[1] / ms[v] : 0)
+    printf "\n"
+  }' $names
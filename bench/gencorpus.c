@@ -0,0 +1,319 @@
+/**
+ * @file gencorpus.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief generates a reproducible synthetic header corpus for benchmarking
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * usage: gencorpus outdir
+ *
+ * Every workload is written to its own subdirectory of outdir and has a
+ * main.c as entry point. Headers are searched with -I<outdir>/<workload>.
+ * The generator uses a fixed seed, so the same corpus is produced on every
+ * run and timings of different builds can be compared.
+ *
+ * deep_include   chain of nested includes
+ * wide_fanout    many headers with include guards, each including a set of
+ *                common headers again
+ * many_defines   thousands of object-like #defines and lines using them
+ * macro_nesting  heavily nested function-like macro invocations
+ * long_lines     lines close to the line buffer size of stcpp
+ * comment_dense  files where most of the bytes are comments
+ * inactive_if    large regions inside false #if conditions
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#define DEEP_DEPTH       200
+#define FANOUT_HEADERS   400
+#define FANOUT_COMMON    10
+#define DEFINES          4000
+#define DEFINE_USES      2000
+#define NESTING_DEPTH    24
+#define NESTING_LINES    3000
+#define LONG_LINES       600
+#define LONG_LINE_LEN    3000
+#define COMMENT_LINES    20000
+#define INACTIVE_LINES   40000
+
+
+static unsigned long seed = 20240807;
+static char outdir[1024];
+
+
+
+/**
+ * @brief simple linear congruential generator, reproducible on all platforms
+ *
+ * @param n upper bound (exclusive)
+ * @return pseudo random number in the range 0..n-1
+ */
+static unsigned rnd(unsigned n)
+{
+  seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+  return (unsigned)(seed >> 33) % n;
+}
+
+
+
+static FILE *openfile(const char *workload, const char *fmt, int n)
+{
+  char fname[256];
+  char path[2048];
+
+  snprintf(path, sizeof(path), "%s/%s", outdir, workload);
+  if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+    perror(path);
+    exit(1);
+  }
+  snprintf(fname, sizeof(fname), fmt, n);
+  snprintf(path, sizeof(path), "%s/%s/%s", outdir, workload, fname);
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  return f;
+}
+
+
+
+static void declarations(FILE *f, const char *prefix, int n, int count)
+{
+  for (int i = 0; i < count; i++) {
+    switch (rnd(4)) {
+      case 0:
+        fprintf(f, "extern int %s_%d_var%d;\n", prefix, n, i);
+        break;
+      case 1:
+        fprintf(f, "int %s_%d_func%d(int a, const char *b, unsigned long c);\n", prefix, n, i);
+        break;
+      case 2:
+        fprintf(f, "typedef struct %s_%d_s%d { int x; long y; char z[%u]; } %s_%d_t%d;\n",
+                prefix, n, i, rnd(64) + 1, prefix, n, i);
+        break;
+      default:
+        fprintf(f, "static const char %s_%d_str%d[] = \"value %u of %s\";\n", prefix, n, i, rnd(100000), prefix);
+        break;
+    }
+  }
+}
+
+
+
+static void gen_deep_include(void)
+{
+  for (int i = 0; i < DEEP_DEPTH; i++) {
+    FILE *f = openfile("deep_include", "h%03d.h", i);
+    fprintf(f, "#ifndef H%03d_H\n#define H%03d_H\n", i, i);
+    declarations(f, "deep", i, 10);
+    if (i + 1 < DEEP_DEPTH) {
+      fprintf(f, "#include \"h%03d.h\"\n", i + 1);
+    }
+    declarations(f, "deep_post", i, 10);
+    fprintf(f, "#endif\n");
+    fclose(f);
+  }
+  FILE *f = openfile("deep_include", "main.c", 0);
+  fprintf(f, "#include \"h000.h\"\nint main() { return 0; }\n");
+  fclose(f);
+}
+
+
+
+static void gen_wide_fanout(void)
+{
+  for (int i = 0; i < FANOUT_COMMON; i++) {
+    FILE *f = openfile("wide_fanout", "common%02d.h", i);
+    fprintf(f, "#ifndef COMMON%02d_H\n#define COMMON%02d_H\n", i, i);
+    declarations(f, "common", i, 40);
+    fprintf(f, "#endif\n");
+    fclose(f);
+  }
+  for (int i = 0; i < FANOUT_HEADERS; i++) {
+    FILE *f = openfile("wide_fanout", "w%03d.h", i);
+    fprintf(f, "#ifndef W%03d_H\n#define W%03d_H\n", i, i);
+    for (int j = 0; j < FANOUT_COMMON; j++) {
+      fprintf(f, "#include \"common%02d.h\"\n", j);
+    }
+    declarations(f, "wide", i, 8);
+    fprintf(f, "#endif\n");
+    fclose(f);
+  }
+  FILE *f = openfile("wide_fanout", "main.c", 0);
+  for (int i = 0; i < FANOUT_HEADERS; i++) {
+    fprintf(f, "#include \"w%03d.h\"\n", i);
+    fprintf(f, "#include \"w%03d.h\"\n", rnd(i + 1));
+  }
+  fprintf(f, "int main() { return 0; }\n");
+  fclose(f);
+}
+
+
+
+static void gen_many_defines(void)
+{
+  FILE *f = openfile("many_defines", "defines.h", 0);
+  fprintf(f, "#ifndef DEFINES_H\n#define DEFINES_H\n");
+  for (int i = 0; i < DEFINES; i++) {
+    if (i > 0 && rnd(4) == 0) {
+      fprintf(f, "#define CONST_%04d (CONST_%04d + %u)\n", i, rnd(i), rnd(1000));
+    } else {
+      fprintf(f, "#define CONST_%04d %uU\n", i, rnd(1000000));
+    }
+  }
+  fprintf(f, "#endif\n");
+  fclose(f);
+
+  f = openfile("many_defines", "main.c", 0);
+  fprintf(f, "#include \"defines.h\"\n");
+  for (int i = 0; i < DEFINE_USES; i++) {
+    fprintf(f, "unsigned long use%d = CONST_%04u + local_%d * CONST_%04u;\n", i, rnd(DEFINES), i, rnd(DEFINES));
+  }
+  fclose(f);
+}
+
+
+
+static void gen_macro_nesting(void)
+{
+  FILE *f = openfile("macro_nesting", "nesting.h", 0);
+  fprintf(f, "#define N0(x) (x)\n");
+  for (int i = 1; i < NESTING_DEPTH; i++) {
+    fprintf(f, "#define N%d(x) N%d((x) + %d)\n", i, i - 1, i);
+  }
+  fprintf(f, "#define SQ(x) ((x) * (x))\n");
+  fprintf(f, "#define MAX(a, b) ((a) > (b) ? (a) : (b))\n");
+  fprintf(f, "#define CLAMP(v, lo, hi) MAX(lo, MAX(v, hi))\n");
+  fprintf(f, "#define CALL(f, a, b) f(a, b)\n");
+  fclose(f);
+
+  f = openfile("macro_nesting", "main.c", 0);
+  fprintf(f, "#include \"nesting.h\"\n");
+  for (int i = 0; i < NESTING_LINES; i++) {
+    switch (rnd(4)) {
+      case 0:
+        fprintf(f, "int n%d = N%u(v%d);\n", i, rnd(NESTING_DEPTH), i);
+        break;
+      case 1:
+        fprintf(f, "int n%d = SQ(SQ(v%d + %u));\n", i, i, rnd(100));
+        break;
+      case 2:
+        fprintf(f, "int n%d = CLAMP(v%d, %u, %u);\n", i, i, rnd(10), rnd(1000));
+        break;
+      default:
+        fprintf(f, "int n%d = CALL(MAX, N%u(a%d), SQ(b%d));\n", i, rnd(8), i, i);
+        break;
+    }
+  }
+  fclose(f);
+}
+
+
+
+static void gen_long_lines(void)
+{
+  FILE *f = openfile("long_lines", "main.c", 0);
+  fprintf(f, "#define LL_SCALE 3\n");
+  for (int i = 0; i < LONG_LINES; i++) {
+    int len = fprintf(f, "long table%d[] = {", i);
+    while (len < LONG_LINE_LEN) {
+      switch (rnd(3)) {
+        case 0:
+          len += fprintf(f, " %u,", rnd(100000));
+          break;
+        case 1:
+          len += fprintf(f, " ident_%u * LL_SCALE,", rnd(1000));
+          break;
+        default:
+          len += fprintf(f, " sizeof(\"string %u\"),", rnd(1000));
+          break;
+      }
+    }
+    fprintf(f, " 0 };\n");
+  }
+  fclose(f);
+}
+
+
+
+static void gen_comment_dense(void)
+{
+  FILE *f = openfile("comment_dense", "main.c", 0);
+  for (int i = 0; i < COMMENT_LINES; i++) {
+    switch (rnd(5)) {
+      case 0:
+        fprintf(f, "/**\n * @brief documentation block %d\n * \n * @param x some parameter\n * @return int\n */\n", i);
+        break;
+      case 1:
+        fprintf(f, "int c%d = %u;  // trailing comment with some words in it %d\n", i, rnd(1000), i);
+        break;
+      case 2:
+        fprintf(f, "// full line comment %d describing the next statement in detail\n", i);
+        break;
+      case 3:
+        fprintf(f, "int d%d /* inline */ = /* comment */ %u;\n", i, rnd(1000));
+        break;
+      default:
+        fprintf(f, "/* single line block comment %d */\n", i);
+        break;
+    }
+  }
+  fclose(f);
+}
+
+
+
+static void gen_inactive_if(void)
+{
+  FILE *f = openfile("inactive_if", "main.c", 0);
+  int lines = 0;
+  int region = 0;
+  fprintf(f, "#define ENABLED 1\n");
+  while (lines < INACTIVE_LINES) {
+    fprintf(f, "#if 0\n");
+    int n = 500 + rnd(1500);
+    for (int i = 0; i < n; i++) {
+      if (rnd(20) == 0) {
+        fprintf(f, "#ifdef NESTED_%d\nint nested%d_%d;\n#else\nint other%d_%d;\n#endif\n", i, region, i, region, i);
+      } else {
+        fprintf(f, "int inactive%d_%d = func(%u, \"text\", 'c');\n", region, i, rnd(1000));
+      }
+    }
+    fprintf(f, "#elif ENABLED\nint active%d;\n#endif\n", region);
+    lines += n;
+    region++;
+  }
+  fclose(f);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  if (argc != 2) {
+    fprintf(stderr, "usage:\n");
+    fprintf(stderr, "gencorpus outdir\n");
+    return 1;
+  }
+  snprintf(outdir, sizeof(outdir), "%s", argv[1]);
+  if (mkdir(outdir, 0755) != 0 && errno != EEXIST) {
+    perror(outdir);
+    return 1;
+  }
+
+  gen_deep_include();
+  gen_wide_fanout();
+  gen_many_defines();
+  gen_macro_nesting();
+  gen_long_lines();
+  gen_comment_dense();
+  gen_inactive_if();
+
+  return 0;
+}
@@ -0,0 +1,439 @@
+/**
+ * @file microbench.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief microbenchmarks for the hot functions of stcpp
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * usage: microbench [-r reps] [-w warmup] [-b batch] [-j]
+ *
+ * The benchmark is linked against the same objects as bin/stcpp. Every
+ * function is measured with a set of input parameters (macro table size,
+ * line length, expression depth, number of search directories), so scaling
+ * curves can be plotted from the output.
+ *
+ * Every measurement runs warmup batches first, then reps batches of batch
+ * calls each. The median of the batches is reported in cycles and
+ * nanoseconds per call. On x86 the time stamp counter is used, otherwise
+ * clock_gettime(CLOCK_MONOTONIC).
+ *
+ * Functions that modify their input (processBuffer, processMacro,
+ * replaceBuf, check_defined) get a fresh copy of the input for every call,
+ * the cost of this copy is reported separately as "copy".
+ *
+ * Output is CSV (default) or JSON (-j).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "input.h"
+#include "macro.h"
+#include "cmdline.h"
+#include "exprint.h"
+#include "alloc.h"
+
+#define LINESIZE  4096
+
+typedef void (*benchfn_t)(void);
+
+static int reps = 15;
+static int warmup = 3;
+static int batch = 200;
+static int json = 0;
+static int nresults = 0;
+static double tscperns = 1.0;
+
+static char line[LINESIZE];
+static char work[LINESIZE];
+static int linelen;
+static char name[320];
+static char tmpdir[64];
+
+
+
+static inline uint64_t cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned aux;
+  _mm_lfence();
+  return __rdtscp(&aux);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+#endif
+}
+
+
+
+static uint64_t nanoseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+
+
+/**
+ * @brief determines the number of timer ticks per nanosecond
+ */
+static void calibrate(void)
+{
+  uint64_t ns = nanoseconds(), c = cycles();
+  while (nanoseconds() - ns < 50000000UL) {
+  }
+  tscperns = (double)(cycles() - c) / (double)(nanoseconds() - ns);
+  if (tscperns <= 0.0) {
+    tscperns = 1.0;
+  }
+}
+
+
+
+static int cmpu64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+
+
+/**
+ * @brief measures fn and prints one result line
+ *
+ * @param func name of the measured function
+ * @param param name of the input parameter
+ * @param value value of the input parameter
+ * @param fn function doing one call of the measured function
+ */
+static void measure(const char *func, const char *param, long value, benchfn_t fn)
+{
+  uint64_t *samples = malloc(sizeof(uint64_t) * reps);
+  if (samples == NULL) {
+    perror("malloc");
+    exit(1);
+  }
+
+  for (int i = 0; i < warmup * batch; i++) {
+    fn();
+  }
+  for (int r = 0; r < reps; r++) {
+    uint64_t start = cycles();
+    for (int i = 0; i < batch; i++) {
+      fn();
+    }
+    samples[r] = cycles() - start;
+  }
+  qsort(samples, reps, sizeof(uint64_t), cmpu64);
+  double percall = (double)samples[reps / 2] / batch;
+  free(samples);
+
+  if (json) {
+    printf("%s  {\"function\": \"%s\", \"param\": \"%s\", \"value\": %ld, \"reps\": %d, \"batch\": %d, "
+           "\"cycles\": %.1f, \"ns\": %.1f}", nresults ? ",\n" : "", func, param, value, reps, batch,
+           percall, percall / tscperns);
+  } else {
+    printf("%s,%s,%ld,%d,%d,%.1f,%.1f\n", func, param, value, reps, batch, percall, percall / tscperns);
+  }
+  nresults++;
+}
+
+
+
+/**
+ * @brief fills the macro table up to n entries named M_0 .. M_<n-1>
+ */
+static void fillmacros(int n)
+{
+  static int defined = 0;
+  char def[64];
+  for (; defined < n; defined++) {
+    snprintf(def, sizeof(def), "M_%d %d", defined, defined);
+    addMacro(def);
+  }
+}
+
+
+
+/**
+ * @brief creates a line of about len chars mixing identifiers, macros, numbers and strings
+ */
+static void makeline(int len, int macros)
+{
+  int n = 0, i = 0;
+  while (n < len - 32) {
+    switch (i++ % 4) {
+      case 0:
+        n += snprintf(line + n, sizeof(line) - n, "M_%d + ", (i * 7919) % macros);
+        break;
+      case 1:
+        n += snprintf(line + n, sizeof(line) - n, "ident%d * ", i);
+        break;
+      case 2:
+        n += snprintf(line + n, sizeof(line) - n, "0x%xUL - ", i);
+        break;
+      default:
+        n += snprintf(line + n, sizeof(line) - n, "\"str %d\", ", i);
+        break;
+    }
+  }
+  n += snprintf(line + n, sizeof(line) - n, "0");
+  linelen = n;
+}
+
+
+
+static void b_copy(void)
+{
+  memcpy(work, line, linelen + 1);
+}
+
+static void b_findmacro(void)
+{
+  if (findMacro(name, name + strlen(name)) == NULL) {
+    abort();
+  }
+}
+
+static void b_findmacro_miss(void)
+{
+  if (findMacro(line, line + linelen) != NULL) {
+    abort();
+  }
+}
+
+static void b_addmacro(void)
+{
+  memcpy(work, line, linelen + 1);
+  addMacro(work);
+  deleteMacro(name);
+}
+
+static void b_processbuffer(void)
+{
+  memcpy(work, line, linelen + 1);
+  processBuffer(work, sizeof(work), 0);
+}
+
+static void b_processmacro(void)
+{
+  memcpy(work, line, linelen + 1);
+  processMacro(work, sizeof(work), 0);
+}
+
+static void b_replacebuf(void)
+{
+  memcpy(work, line, linelen + 1);
+  replaceBuf(work, work + 8, work + sizeof(work), "replacement");
+}
+
+static void b_evaluate(void)
+{
+  evaluate_expression(line);
+}
+
+static void b_checkdefined(void)
+{
+  memcpy(work, line, linelen + 1);
+  check_defined(work, work + sizeof(work));
+}
+
+static void b_checkpath(void)
+{
+  xfree(ALLOC_PATH, checkpath(name, 0));
+}
+
+static void b_readline(void)
+{
+  if (getcurrentinstream() == NULL) {
+    newinstream(name, 1);
+  }
+  readline(NULL, work, sizeof(work));
+}
+
+
+
+static void bench_findmacro(void)
+{
+  static const int sizes[] = { 10, 100, 1000, 4000 };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    fillmacros(sizes[i]);
+    snprintf(name, sizeof(name), "M_%d", sizes[i] / 2);
+    measure("findMacro", "macros", sizes[i], b_findmacro);
+    linelen = snprintf(line, sizeof(line), "not_a_macro");
+    measure("findMacro_miss", "macros", sizes[i], b_findmacro_miss);
+    snprintf(name, sizeof(name), "NEW_MACRO");
+    linelen = snprintf(line, sizeof(line), "NEW_MACRO(a, b) ((a) + (b))");
+    measure("addMacro", "macros", sizes[i], b_addmacro);
+  }
+}
+
+
+
+static void bench_processbuffer(void)
+{
+  static const int lens[] = { 64, 256, 1024, 3072 };
+  for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+    makeline(lens[i], 1000);
+    measure("copy", "linelen", lens[i], b_copy);
+    measure("processBuffer", "linelen", lens[i], b_processbuffer);
+    measure("replaceBuf", "linelen", lens[i], b_replacebuf);
+  }
+
+  char def[64];
+  snprintf(def, sizeof(def), "BENCH_MAX(a, b) ((a) > (b) ? (a) : (b))");
+  addMacro(def);
+  static const int argl[] = { 1, 16, 256 };
+  for (size_t i = 0; i < sizeof(argl) / sizeof(argl[0]); i++) {
+    linelen = snprintf(line, sizeof(line), "BENCH_MAX(%0*d, %0*d) + tail", argl[i], 1, argl[i], 2);
+    measure("processMacro", "arglen", argl[i], b_processmacro);
+  }
+}
+
+
+
+static void bench_expression(void)
+{
+  static const int depths[] = { 1, 4, 16, 64 };
+  for (size_t i = 0; i < sizeof(depths) / sizeof(depths[0]); i++) {
+    int n = 0;
+    for (int d = 0; d < depths[i]; d++) {
+      n += snprintf(line + n, sizeof(line) - n, "(%d+", d);
+    }
+    n += snprintf(line + n, sizeof(line) - n, "1");
+    for (int d = 0; d < depths[i]; d++) {
+      n += snprintf(line + n, sizeof(line) - n, ")*2");
+    }
+    linelen = n;
+    measure("evaluate_expression", "depth", depths[i], b_evaluate);
+
+    n = 0;
+    for (int d = 0; d < depths[i]; d++) {
+      n += snprintf(line + n, sizeof(line) - n, "defined(M_%d)&&", d);
+    }
+    n += snprintf(line + n, sizeof(line) - n, "1");
+    linelen = n;
+    measure("check_defined", "defined", depths[i], b_checkdefined);
+  }
+}
+
+
+
+static void bench_input(void)
+{
+  static const int dirs[] = { 1, 4, 16, 64 };
+  char path[128];
+  int added = 0;
+
+  for (size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+    for (; added < dirs[i]; added++) {
+      snprintf(path, sizeof(path), "%s/d%d", tmpdir, added);
+      mkdir(path, 0755);
+      if (added == 0) {
+        snprintf(path, sizeof(path), "%s/d0/bench.h", tmpdir);
+        FILE *f = fopen(path, "w");
+        if (f != NULL) {
+          fclose(f);
+        }
+        snprintf(path, sizeof(path), "%s/d%d", tmpdir, added);
+      }
+      addsearchdir(strdup(path));
+    }
+    snprintf(name, sizeof(name), "bench.h");
+    measure("checkpath", "searchdirs", dirs[i], b_checkpath);
+  }
+
+  static const int lens[] = { 16, 80, 256, 1024 };
+  for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+    snprintf(name, sizeof(name), "%s/lines%d.c", tmpdir, lens[i]);
+    FILE *f = fopen(name, "w");
+    if (f == NULL) {
+      perror(name);
+      exit(1);
+    }
+    for (int l = 0; l < 20000; l++) {
+      for (int c = 0; c < lens[i] - 1; c++) {
+        fputc(c % 8 == 7 ? ' ' : 'a' + (c + l) % 26, f);
+      }
+      fputc('\n', f);
+    }
+    fclose(f);
+    measure("readline", "linelen", lens[i], b_readline);
+    while (getcurrentinstream() != NULL) {
+      releaseinstream(getcurrentinstream());
+    }
+    remove(name);
+  }
+}
+
+
+
+int main(int argc, char *argv[])
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "r:w:b:j")) != -1) {
+    switch (opt) {
+      case 'r':
+        reps = atoi(optarg);
+        break;
+      case 'w':
+        warmup = atoi(optarg);
+        break;
+      case 'b':
+        batch = atoi(optarg);
+        break;
+      case 'j':
+        json = 1;
+        break;
+      default:
+        fprintf(stderr, "usage:\n");
+        fprintf(stderr, "microbench [-r reps] [-w warmup] [-b batch] [-j]\n");
+        return 1;
+    }
+  }
+  if (reps < 1 || batch < 1 || warmup < 0) {
+    fprintf(stderr, "microbench: invalid repetition count\n");
+    return 1;
+  }
+
+  snprintf(tmpdir, sizeof(tmpdir), "/tmp/microbench.XXXXXX");
+  if (mkdtemp(tmpdir) == NULL) {
+    perror("mkdtemp");
+    return 1;
+  }
+
+  calibrate();
+  if (json) {
+    printf("{\"ticks_per_ns\": %.4f, \"results\": [\n", tscperns);
+  } else {
+    printf("function,param,value,reps,batch,cycles,ns\n");
+  }
+
+  bench_findmacro();
+  bench_processbuffer();
+  bench_expression();
+  bench_input();
+
+  if (json) {
+    printf("\n]}\n");
+  }
+
+  char cmd[300];
+  snprintf(cmd, sizeof(cmd), "rm -rf %s", tmpdir);
+  if (system(cmd) != 0) {
+    fprintf(stderr, "microbench: could not remove %s\n", tmpdir);
+  }
+  return 0;
+}
@@ -0,0 +1,167 @@
+#!/bin/sh
+#
+# regress.sh - compares stcpp with gcc -E -P on programs using the system headers
+#
+# usage: regress.sh [-u] stcpp corpusdir baseline [runs] [tolerance]
+#
+# Every program of corpusdir is preprocessed by gcc -E -P and by stcpp. The
+# outputs are split into tokens, so whitespace and line breaks do not count,
+# and the tokens which differ are counted. The predefined macros of gcc
+# (gcc -dM -E) are given to stcpp by a wrapper file, the include search path
+# is the one gcc reports.
+#
+# Both tools run runs times (default 5), the median wall times give stcpp's
+# time relative to gcc. As the ratio is measured against gcc on the same
+# machine, it can be compared with a baseline from another machine.
+#
+# The check fails if stcpp exits with an error or writes any message but
+# warnings, if the tokens of a program differ from gcc's although the
+# baseline does not list it as known to differ, or if the total ratio is
+# more than tolerance percent (default 10) above the baseline ratio. With -u
+# the baseline is rewritten with the current results instead, unless stcpp
+# failed.
+#
+
+UPDATE=0
+if [ "$1" = "-u" ]; then
+  UPDATE=1
+  shift
+fi
+
+STCPP=$1
+CORPUS=$2
+BASELINE=$3
+RUNS=${4:-5}
+TOLERANCE=${5:-10}
+
+if [ -z "$STCPP" ] || [ -z "$CORPUS" ] || [ -z "$BASELINE" ]; then
+  echo "usage:" >&2
+  echo "regress.sh [-u] stcpp corpusdir baseline [runs] [tolerance]" >&2
+  exit 1
+fi
+
+CC=${CC:-gcc}
+TMP=$(mktemp -d /tmp/stcpp_regress.XXXXXX)
+trap 'rm -rf "$TMP"' EXIT
+
+now() {
+  date +%s%N
+}
+
+median() {
+  echo "$@" | tr ' ' '\n' | sort -n | awk '{ t[NR] = $1 } END { print (NR % 2) ? t[(NR + 1) / 2] : (t[NR / 2] + t[NR / 2 + 1]) / 2 }'
+}
+
+tokens() {
+  grep -oE '[A-Za-z_][A-Za-z_0-9]*|[0-9.][A-Za-z0-9_.]*|"([^"\\]|\\.)*"|'"'"'([^'"'"'\\]|\\.)*'"'"'|<<=|>>=|->|\+\+|--|<<|>>|<=|>=|==|!=|&&|\|\||\.\.\.|##|[^[:space:]]' "$1"
+}
+
+# predefined macros and include search path of gcc, stcpp searches the
+# directory given last first, so the order is reversed
+$CC -dM -E - < /dev/null > "$TMP/predefs.h"
+INCS=""
+for dir in $($CC -E -Wp,-v - < /dev/null 2>&1 | sed -n '/<\.\.\.> search starts here:/,/End of search list/p' | grep '^ '); do
+  INCS="-I$dir $INCS"
+done
+
+CORPUS=$(cd "$CORPUS" && pwd)
+RESULT="$TMP/result"
+FAILED=0
+printf "%-12s %8s %10s %10s %10s %7s\n" program tokens mismatches gcc_ms stcpp_ms ratio
+for src in "$CORPUS"/*.c; do
+  name=$(basename "$src" .c)
+  printf '#include "predefs.h"\n#include "%s.c"\n' "$name" > "$TMP/w_$name.c"
+
+  gtimes=""
+  stimes=""
+  i=0
+  while [ $i -lt "$RUNS" ]; do
+    start=$(now)
+    if ! $CC -E -P "$src" -o "$TMP/gcc.i" 2> /dev/null; then
+      echo "$name: gcc failed" >&2
+      exit 1
+    fi
+    end=$(now)
+    gtimes="$gtimes $((end - start))"
+    start=$(now)
+    "$STCPP" $INCS -I"$CORPUS" -I"$TMP" "$TMP/w_$name.c" "$TMP/stcpp.i" > /dev/null 2> "$TMP/stcpp.err"
+    status=$?
+    end=$(now)
+    stimes="$stimes $((end - start))"
+    i=$((i + 1))
+    grep -v -e '^CPATH not set$' -e ': warning: ' "$TMP/stcpp.err" > "$TMP/stcpp.msg"
+    if [ $status -ne 0 ] || [ -s "$TMP/stcpp.msg" ]; then
+      echo "FAIL $name: stcpp exited with status $status" >&2
+      sed 's/^/  /' "$TMP/stcpp.msg" >&2
+      FAILED=1
+      break
+    fi
+  done
+
+  tokens "$TMP/gcc.i" > "$TMP/gcc.tok"
+  if [ -f "$TMP/stcpp.i" ]; then
+    tokens "$TMP/stcpp.i" > "$TMP/stcpp.tok"
+  else
+    : > "$TMP/stcpp.tok"
+  fi
+  rm -f "$TMP/stcpp.i"
+  ntok=$(wc -l < "$TMP/gcc.tok")
+  mismatches=$(diff "$TMP/gcc.tok" "$TMP/stcpp.tok" | grep -c '^[<>]')
+  printf "%s %d %d %d %d\n" "$name" "$ntok" "$mismatches" "$(median $gtimes)" "$(median $stimes)" >> "$RESULT"
+  awk -v n="$name" -v k="$ntok" -v m="$mismatches" -v g="$(median $gtimes)" -v s="$(median $stimes)" 'BEGIN {
+    printf "%-12s %8d %10d %10.2f %10.2f %7.2f\n", n, k, m, g / 1e6, s / 1e6, (g > 0 ? s / g : 0)
+  }'
+done
+
+awk '{ g += $4; s += $5 } END {
+  printf "%-12s %8s %10s %10.2f %10.2f %7.2f\n", "total", "", "", g / 1e6, s / 1e6, (g > 0 ? s / g : 0)
+}' "$RESULT"
+
+if [ $FAILED -ne 0 ]; then
+  exit 1
+fi
+
+if [ $UPDATE -eq 1 ]; then
+  {
+    echo "# regress.sh baseline: program, ok if its tokens match gcc's or differs if known to differ,"
+    echo "# stcpp time relative to gcc"
+    awk '{ printf "%s\t%s\t%.3f\n", $1, ($3 > 0 ? "differs" : "ok"), ($4 > 0 ? $5 / $4 : 0) }' "$RESULT"
+    awk '{ g += $4; s += $5 } END { printf "total\t\t%.3f\n", (g > 0 ? s / g : 0) }' "$RESULT"
+  } > "$BASELINE"
+  echo "baseline $BASELINE updated"
+  exit 0
+fi
+
+if [ ! -f "$BASELINE" ]; then
+  echo "no baseline $BASELINE, run with -u to create it" >&2
+  exit 1
+fi
+
+awk -v tol="$TOLERANCE" -F '\t' '
+  FNR == NR {
+    if ($0 !~ /^#/) {
+      if ($1 == "total") ratio = $3
+      else known[$1] = $2
+    }
+    next
+  }
+  {
+    split($0, f, " ")
+    g += f[4]
+    s += f[5]
+    if (f[3] > 0 && known[f[1]] != "differs") {
+      printf "FAIL %s: %d tokens differ from gcc\n", f[1], f[3]
+      fail = 1
+    } else if (f[3] == 0 && known[f[1]] == "differs") {
+      printf "NOTE %s: matches gcc now, update the baseline\n", f[1]
+    }
+  }
+  END {
+    cur = g > 0 ? s / g : 0
+    if (ratio > 0 && cur > ratio * (1 + tol / 100)) {
+      printf "FAIL throughput: %.3f x gcc, baseline %.3f x gcc, tolerance %d%%\n", cur, ratio, tol
+      fail = 1
+    }
+    if (!fail) printf "PASS: %.3f x gcc, baseline %.3f x gcc\n", cur, ratio
+    exit fail
+  }' "$BASELINE" "$RESULT"
@@ -0,0 +1,17 @@
+#include <time.h>
+#include <signal.h>
+
+static volatile sig_atomic_t stop;
+
+static void onalarm(int sig)
+{
+  stop = sig == SIGALRM;
+}
+
+long elapsed(void)
+{
+  struct timespec ts;
+  signal(SIGALRM, onalarm);
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * CLOCKS_PER_SEC + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,8 @@
+#include <stdio.h>
+
+int main(void)
+{
+  printf("hello, world\n");
+  fputs("bye\n", stderr);
+  return EOF + 1;
+}
@@ -0,0 +1,14 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+uint32_t *table(size_t n)
+{
+  uint32_t *t = calloc(n, sizeof(uint32_t));
+  if (t == NULL) {
+    errno = ENOMEM;
+    exit(EXIT_FAILURE);
+  }
+  t[0] = UINT32_MAX;
+  return t;
+}
@@ -0,0 +1,14 @@
+#include <math.h>
+#include <limits.h>
+#include <float.h>
+
+double clampsqrt(double x)
+{
+  if (isnan(x) || x < 0.0) {
+    return NAN;
+  }
+  if (x > DBL_MAX / 2) {
+    return HUGE_VAL;
+  }
+  return sqrt(x) + INT_MAX + CHAR_BIT;
+}
@@ -0,0 +1,14 @@
+#include <string.h>
+#include <ctype.h>
+#include <stddef.h>
+
+size_t upcase(char *s)
+{
+  size_t n = strlen(s);
+  for (size_t i = 0; i < n; i++) {
+    if (islower((unsigned char)s[i])) {
+      s[i] = toupper((unsigned char)s[i]);
+    }
+  }
+  return n + offsetof(struct { char c; int i; }, i);
+}
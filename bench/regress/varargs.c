@@ -0,0 +1,16 @@
+#include <stdarg.h>
+#include <assert.h>
+#include <stdbool.h>
+
+int sum(int n, ...)
+{
+  va_list ap;
+  int s = 0;
+  assert(n >= 0);
+  va_start(ap, n);
+  while (n-- > 0) {
+    s += va_arg(ap, int);
+  }
+  va_end(ap);
+  return s + true;
+}
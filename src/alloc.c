@@ -0,0 +1,223 @@
+/**
+ * @file alloc.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief memory allocation with accounting per subsystem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * All allocations of stcpp go through xmalloc() and friends with a tag
+ * naming the subsystem. Every block carries a small header with its size
+ * and tag, so xfree() can account the released bytes. Per tag the number
+ * of allocations and frees, the allocated bytes, the live bytes and the
+ * peak of the live bytes are counted. Live bytes at exit are leaks, as
+ * main() releases everything it still holds before the report. An
+ * allocation exceeding the limit of the macro table or of the total memory
+ * fails like on out of memory.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_ALLOC
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug.h"
+#include "alloc.h"
+#include "bounds.h"
+
+
+typedef union allochdr {
+  struct {
+    size_t size;
+    alloctag_t tag;
+  } h;
+  max_align_t align;
+} allochdr_t;
+
+
+typedef struct alloccount {
+  unsigned long allocs;
+  unsigned long frees;
+  unsigned long bytes;
+  unsigned long live;
+  unsigned long peak;
+} alloccount_t;
+
+
+static const char *tagnames[ALLOC_TAGS] = {
+  "macro defs",
+  "expansion temps",
+  "include streams",
+  "paths",
+  "cond stack",
+  "reports"
+};
+
+static alloccount_t counts[ALLOC_TAGS];
+static unsigned long totallive = 0, totalpeak = 0;
+
+
+
+static void account(alloctag_t tag, size_t size)
+{
+  alloccount_t *c = &counts[tag];
+  c->allocs++;
+  c->bytes += size;
+  c->live += size;
+  if (c->live > c->peak) {
+    c->peak = c->live;
+  }
+  totallive += size;
+  if (totallive > totalpeak) {
+    totalpeak = totallive;
+  }
+}
+
+
+
+static void unaccount(alloctag_t tag, size_t size)
+{
+  counts[tag].frees++;
+  counts[tag].live -= size;
+  totallive -= size;
+}
+
+
+
+/**
+ * @brief checks if grow more bytes accounted to tag are within the limits
+ */
+static int withinbounds(alloctag_t tag, size_t grow)
+{
+  if (tag == ALLOC_MACRO && bounds_check(BOUND_MACRO_BYTES, counts[ALLOC_MACRO].live + grow) != 0) {
+    return 0;
+  }
+  return bounds_check(BOUND_MEMORY, totallive + grow) == 0;
+}
+
+
+
+/**
+ * @brief allocates size bytes accounted to tag
+ *
+ * @return pointer to the memory, NULL if out of memory or beyond a limit
+ */
+void *xmalloc(alloctag_t tag, size_t size)
+{
+  if (!withinbounds(tag, size)) {
+    DPRINTERR("xmalloc: %zu bytes of tag %d beyond the limit\n", size, tag);
+    return NULL;
+  }
+  allochdr_t *hdr = malloc(sizeof(allochdr_t) + size);
+  if (hdr == NULL) {
+    DPRINTERR("xmalloc: out of memory for %zu bytes of tag %d\n", size, tag);
+    return NULL;
+  }
+  hdr->h.size = size;
+  hdr->h.tag = tag;
+  account(tag, size);
+  return hdr + 1;
+}
+
+
+
+void *xcalloc(alloctag_t tag, size_t n, size_t size)
+{
+  void *ptr = xmalloc(tag, n * size);
+  if (ptr != NULL) {
+    memset(ptr, 0, n * size);
+  }
+  return ptr;
+}
+
+
+
+void *xrealloc(alloctag_t tag, void *ptr, size_t size)
+{
+  if (ptr == NULL) {
+    return xmalloc(tag, size);
+  }
+  allochdr_t *hdr = (allochdr_t *)ptr - 1;
+  size_t old = hdr->h.size;
+  assert(hdr->h.tag == tag);
+  if (size > old && !withinbounds(tag, size - old)) {
+    DPRINTERR("xrealloc: %zu bytes of tag %d beyond the limit\n", size, tag);
+    return NULL;
+  }
+  hdr = realloc(hdr, sizeof(allochdr_t) + size);
+  if (hdr == NULL) {
+    DPRINTERR("xrealloc: out of memory for %zu bytes of tag %d\n", size, tag);
+    return NULL;
+  }
+  unaccount(tag, old);
+  account(tag, size);
+  hdr->h.size = size;
+  return hdr + 1;
+}
+
+
+
+char *xstrdup(alloctag_t tag, const char *s)
+{
+  size_t len = strlen(s) + 1;
+  char *p = xmalloc(tag, len);
+  if (p != NULL) {
+    memcpy(p, s, len);
+  }
+  return p;
+}
+
+
+
+/**
+ * @brief releases memory allocated with tag, NULL is ignored
+ */
+void xfree(alloctag_t tag, void *ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+  allochdr_t *hdr = (allochdr_t *)ptr - 1;
+  assert(hdr->h.tag == tag);
+  unaccount(hdr->h.tag, hdr->h.size);
+  (void)tag;
+  free(hdr);
+}
+
+
+
+/**
+ * @brief total number of allocations so far
+ */
+unsigned long alloc_count()
+{
+  unsigned long n = 0;
+  for (int i = 0; i < ALLOC_TAGS; i++) {
+    n += counts[i].allocs;
+  }
+  return n;
+}
+
+
+
+/**
+ * @brief prints the allocation counters per tag, live bytes are the leaks at exit
+ *
+ * @param out stream to print to
+ */
+void alloc_report(FILE *out)
+{
+  alloccount_t total = { 0, 0, 0, 0, 0 };
+
+  fprintf(out, "%-18s %10s %10s %12s %12s %12s\n", "allocations", "allocs", "frees", "bytes", "peak live", "leaked");
+  for (int i = 0; i < ALLOC_TAGS; i++) {
+    alloccount_t *c = &counts[i];
+    fprintf(out, "%-18s %10lu %10lu %12lu %12lu %12lu\n", tagnames[i], c->allocs, c->frees, c->bytes,
+            c->peak, c->live);
+    total.allocs += c->allocs;
+    total.frees += c->frees;
+    total.bytes += c->bytes;
+  }
+  fprintf(out, "%-18s %10lu %10lu %12lu %12lu %12lu\n", "total", total.allocs, total.frees, total.bytes,
+          totalpeak, totallive);
+}
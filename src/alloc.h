@@ -0,0 +1,37 @@
+/**
+ * @file alloc.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief memory allocation with accounting per subsystem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+typedef enum alloctag {
+  ALLOC_MACRO,      // macro definitions
+  ALLOC_EXPAND,     // temporaries of macro expansion
+  ALLOC_STREAM,     // include streams and the include file registry
+  ALLOC_PATH,       // path names and search directories
+  ALLOC_COND,       // conditional stack
+  ALLOC_REPORT,     // profiles, traces and reports
+  ALLOC_TAGS
+} alloctag_t;
+
+
+void *xmalloc(alloctag_t tag, size_t size);
+void *xcalloc(alloctag_t tag, size_t n, size_t size);
+void *xrealloc(alloctag_t tag, void *ptr, size_t size);
+char *xstrdup(alloctag_t tag, const char *s);
+void xfree(alloctag_t tag, void *ptr);
+unsigned long alloc_count();
+void alloc_report(FILE *out);
+
+#endif  // ALLOC_H
@@ -0,0 +1,114 @@
+/**
+ * @file bounds.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief limits on include depth, memory and expansion size
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The limits keep a runaway input from taking down the host: includes
+ * nested without end, a macro table or expansions growing without bound.
+ * They are set with --limits=name=value,... and checked where the value
+ * grows: newinstream() checks the include depth, the allocator the live
+ * bytes and processBuffer() how much a top-level expansion, with the
+ * expansions rescanned inside of it, grows over the invocation it replaces.
+ * A limit of 0 is no limit, only the include depth is limited by default.
+ *
+ * The first violation is reported on stderr and sets bounds_exceeded. The
+ * check fails, so the operation is refused like on out of memory, and
+ * main() stops at the end of the line.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_LIMITS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug.h"
+#include "bounds.h"
+
+
+static const char *boundnames[BOUNDS] = {
+  "include-depth",
+  "macro-bytes",
+  "expansion-bytes",
+  "memory"
+};
+
+unsigned long bounds_limit[BOUNDS] = { 200, 0, 0, 0 };
+int bounds_exceeded = 0;
+
+
+
+/**
+ * @brief sets limits from a spec like "include-depth=50,memory=64M"
+ *
+ * Sizes may have the suffix k, M or G, 0 removes a limit.
+ *
+ * @param spec comma separated list of name=value
+ * @return 0 on success, -1 if a name or value is unknown
+ */
+int bounds_set(const char *spec)
+{
+  while (*spec != '\0') {
+    int len = strcspn(spec, ",");
+    int namelen = strcspn(spec, "=,");
+    int kind = 0;
+    while (kind < BOUNDS && (strncmp(spec, boundnames[kind], namelen) != 0 || boundnames[kind][namelen] != '\0')) {
+      kind++;
+    }
+    if (kind == BOUNDS || namelen == len) {
+      fprintf(stderr, "Unknown limit: %.*s\n", len, spec);
+      return -1;
+    }
+    char *end;
+    unsigned long value = strtoul(spec + namelen + 1, &end, 10);
+    switch (*end) {
+      case 'k':
+        value <<= 10;
+        end++;
+        break;
+      case 'M':
+        value <<= 20;
+        end++;
+        break;
+      case 'G':
+        value <<= 30;
+        end++;
+        break;
+      default:
+        break;
+    }
+    if (end == spec + namelen + 1 || end != spec + len) {
+      fprintf(stderr, "Invalid value of limit: %.*s\n", len, spec);
+      return -1;
+    }
+    bounds_limit[kind] = value;
+    spec += len;
+    if (*spec == ',') {
+      spec++;
+    }
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief checks a value against its limit, the first violation is reported
+ *
+ * @return 0 if the value is within the limit, -1 if it exceeds it
+ */
+int bounds_check(boundkind_t kind, unsigned long value)
+{
+  if (bounds_limit[kind] == 0 || value <= bounds_limit[kind]) {
+    return 0;
+  }
+  DPRINTERR("bounds_check: %s %lu > %lu\n", boundnames[kind], value, bounds_limit[kind]);
+  if (!bounds_exceeded) {
+    fprintf(stderr, "Limit exceeded: %s %lu > %lu\n", boundnames[kind], value, bounds_limit[kind]);
+    bounds_exceeded = 1;
+  }
+  return -1;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file bounds.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief limits on include depth, memory and expansion size
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+typedef enum boundkind {
+  BOUND_INCLUDE_DEPTH,  // nested include files
+  BOUND_MACRO_BYTES,    // live bytes of the macro table
+  BOUND_EXPANSION,      // growth of one top-level expansion over its invocation
+  BOUND_MEMORY,         // live bytes of all allocations
+  BOUNDS
+} boundkind_t;
+
+extern unsigned long bounds_limit[BOUNDS];
+extern int bounds_exceeded;
+
+int bounds_set(const char *spec);
+int bounds_check(boundkind_t kind, unsigned long value);
+
+#endif  // BOUNDS_H
@@ -9,15 +9,20 @@
  * 
  */
 #define NDEBUG
+#define DBG_SUBSYSTEM DBG_DIRECTIVE
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 
 #include "debug.h"
 #include "cmdline.h"
 #include "input.h"
 #include "macro.h"
 #include "exprint.h"
+#include "stats.h"
+#include "trace.h"
+#include "header.h"
+#include "alloc.h"
+#include "token.h"
 
 
 
@@ -58,13 +63,18 @@ const char *cmdnames[] = {
 
 typedef struct cmdcond {
   cmdcondstate_t state;
-  int ifstate;            // 1 if the condition is true, 0 otherwise
+  int ifstate;            // 1 if a group of the conditional was taken, 0 otherwise
+  int kept;               // partial mode: the directives of the conditional are written
   struct cmdcond *prev;   // previous condition
 } cmdcond_t;
 
 
 cmdcond_t *cmdcond = NULL;
 int condstate = 1;
+int conddepth = 0;        // number of conditions on the cmdcond stack
+int partialmode = 0;      // resolve only the conditionals on known macros, see partialcmdline()
+static char **undefnames = NULL;  // macros known to be undefined, by -U
+static int nundefnames = 0;
 
 /**
  * @brief Check if a line is a command line.
@@ -90,21 +100,24 @@ int iscmdline(char *line)
 /**
  * @brief Get the type of a command.
  * 
- * This function takes a command string as input and returns its type as an integer.
+ * This function takes the directive name token as input and returns its type as an integer.
  * The type is determined by the position of the command in the cmdnames array.
  * If the command is not found in the array, it returns UNKNOWN.
  * If the command is NULL, it returns Err.
  * 
- * @param cmd The command string.
+ * @param cmd The directive name token, TK_END for an empty command.
  * @return The type of the command as an cmdtoken_t, or UNKNOWN if the command is not found, or Err if the command is NULL.
  */
-cmdtoken_t getcmdtype(char *cmd)
+cmdtoken_t getcmdtype(const pptoken_t *cmd)
 {
   if (cmd == NULL) {
     return Err;
   }
+  if (cmd->kind == TK_END) {
+    return EMPTY;
+  }
   for (int i = 0; i < (int)(sizeof(cmdnames) / sizeof(cmdnames[0])); i++) {
-    if (strcmp(cmd, cmdnames[i]) == 0) {
+    if (tokenis(cmd, cmdnames[i])) {
       return i;
     }
   }
@@ -113,97 +126,150 @@ cmdtoken_t getcmdtype(char *cmd)
 
 
 
-int check_defined(char *buf, char *end)
+/**
+ * @brief Get the name of a command type.
+ *
+ * @param cmd The command type as cmdtoken_t.
+ * @return The name of the command, "null" for an empty command or "unknown".
+ */
+const char *getcmdname(int cmd)
 {
-  assert(buf != NULL);
-  assert(end != NULL);
-
-  char *strend = buf + strlen(buf) + 1;
-  char *start = buf;
-  char *macro_start, *macro_end, *defined_end;
-  char replace[2];  // Buffer to hold the ASCII number
-
-  if (buf >= end || strend >= end) {
-    fprintf(stderr, "check_defined: buffer overflow\n");
-    return -1;  // error
+  if (cmd == EMPTY) {
+    return "null";
   }
-  while (start < strend)
-  {
-    int pmode = 0;
-    // Find the start of a "defined" expression
-    if ((start = strstr(start, "defined")) != NULL)
-    {
-      buf = start + 7;  // Move past "defined" keyword
-      while (isspace(*buf)) ++buf;  // Skip whitespace
-
-      if (*buf == '(') {  // If macro is in parentheses
-        macro_start = buf + 1;  // Move past "(" to the start of the macro name
-        defined_end = strchr(macro_start, ')');  // Find the end of the macro name
-        if (defined_end == NULL) {
-          fprintf(stderr, "check_defined: missing ')'\n");
-          return -1;
-        }
-        pmode = 1;
-      } else {  // If macro is not in parentheses
-        macro_start = buf;
-        defined_end = strend;
-      }
+  if (cmd > EMPTY && cmd < (int)(sizeof(cmdnames) / sizeof(cmdnames[0]))) {
+    return cmdnames[cmd];
+  }
+  return "unknown";
+}
 
-      while (isspace(*macro_start)) ++macro_start;  // Skip whitespace
 
-      buf = macro_start;
-      while (buf < defined_end) {
-        if (!isIdent(*buf, buf - macro_start)) {
-          break;
-        }
-        ++buf;
-      }
-      if (buf == macro_start) {
-        fprintf(stderr, "check_defined: missing/wrong macro name\n");
-        return -1;
-      }
-      macro_end = buf;  // Move back to the end of the macro name
-      if (pmode == 0) {
-        defined_end = buf;
-      }
 
-      // Check if the macro is defined and get the ASCII number
-      replace[0] = isdefinedMacro(macro_start, macro_end) + '0';
-      replace[1] = '\0';
+/**
+ * @brief Undefines a macro and records it as known to be undefined, for -U.
+ *
+ * @param name The name of the macro.
+ * @return 0 on success, -1 if out of memory.
+ */
+int addundefined(const char *name)
+{
+  char **names = xrealloc(ALLOC_MACRO, undefnames, sizeof(char *) * (nundefnames + 1));
+  if (names == NULL) {
+    return -1;
+  }
+  undefnames = names;
+  int len = strlen(name);
+  char *copy = xmalloc(ALLOC_MACRO, len + 1);
+  if (copy == NULL) {
+    return -1;
+  }
+  memcpy(copy, name, len + 1);
+  undefnames[nundefnames++] = copy;
+  deleteMacro(copy);
+  return 0;
+}
 
-      // Replace the "defined(macro)" expression with the ASCII number
-      replaceBuf(start, defined_end, strend, replace);
 
-      // Update strend in case the buffer size has changed
-      strend = start + strlen(start) + 1;
 
-      // Move past the "defined(macro)" expression replacement
-      start++;
-    } else {
-      // No more "defined(macro)" expressions
-      break;
+/**
+ * @brief Checks if a name was given by -U.
+ */
+static int isundefined(const char *start, int len)
+{
+  for (int i = 0; i < nundefnames; i++) {
+    if (strncmp(undefnames[i], start, len) == 0 && undefnames[i][len] == '\0') {
+      return 1;
     }
   }
-
-  DPRINT("check_defined ok\n");
   return 0;
 }
 
 
 
-void stripspaces(char *buf)
+/**
+ * @brief Tells if a macro is defined.
+ *
+ * In partial mode only the macros defined or undefined on the command line
+ * are known, any other name is unknown.
+ *
+ * @return 1 if defined, 0 if not, -1 if unknown.
+ */
+static int macrostate(char *start, char *end)
+{
+  if (isdefinedMacro(start, end)) {
+    return 1;
+  }
+  return partialmode && !isundefined(start, end - start) ? -1 : 0;
+}
+
+
+
+/**
+ * @brief Replaces each "defined name" and "defined ( name )" in an #if expression by 1 or 0.
+ *
+ * Only the identifier defined is the operator, a name containing it is left
+ * to the macro expansion. In partial mode the operator on an unknown macro
+ * is left as it is.
+ *
+ * @param buf The terminated expression.
+ * @param end End of the buffer.
+ * @return 0 on success, -1 on a malformed operand.
+ */
+int check_defined(char *buf, char *end)
 {
   assert(buf != NULL);
+  assert(end != NULL);
 
-  char *dest = buf;
-  while (*buf != '\0') {
-    if (isspace(*buf)) {
-      buf++;
-    } else {
-      *dest++ = *buf++;
+  char *strend = buf + strlen(buf) + 1;
+  char replace[2];  // Buffer to hold the ASCII number
+  pptoken_t tok;
+
+  if (buf >= end || strend >= end) {
+    fprintf(stderr, "check_defined: buffer overflow\n");
+    return -1;  // error
+  }
+  for (;;) {
+    char *next = lextoken(buf, end, &tok);
+    if (tok.kind == TK_END) {
+      break;
+    }
+    if (tok.kind != TK_IDENT || !tokenis(&tok, "defined")) {
+      buf = next;
+      continue;
+    }
+    pptoken_t name, paren;
+    char *defined_end = lextoken(next, end, &name);
+    int pmode = tokenis(&name, "(");
+    if (pmode) {  // If macro is in parentheses
+      defined_end = lextoken(defined_end, end, &name);
     }
+    if (name.kind != TK_IDENT) {
+      fprintf(stderr, "check_defined: missing/wrong macro name\n");
+      return -1;
+    }
+    if (pmode) {
+      defined_end = lextoken(defined_end, end, &paren);
+      if (!tokenis(&paren, ")")) {
+        fprintf(stderr, "check_defined: missing ')'\n");
+        return -1;
+      }
+    }
+
+    // Check if the macro is defined and get the ASCII number
+    int state = macrostate(name.start, name.start + name.len);
+    if (state < 0) {
+      buf = defined_end;
+      continue;
+    }
+    replace[0] = state + '0';
+    replace[1] = '\0';
+
+    // Replace the "defined(macro)" expression with the ASCII number and move past it
+    buf = replaceBuf(tok.start, defined_end, end, replace);
   }
-  *dest = '\0';
+
+  DLOG(DBG_TRACE, "check_defined ok\n");
+  return 0;
 }
 
 
@@ -215,21 +281,30 @@ int evalifexpr(char *buf, char *end, result_t *result)
   assert(result != NULL);
   *result = 0;
 
-  DPRINT("ifEvalpre: %s\n", buf);
-  stripspaces(buf);
+  DLOG(DBG_TRACE, "ifEvalpre: %s\n", buf);
+  if (trace_enabled) {
+    trace_begin("if", buf);
+  }
   if (check_defined(buf, end) != 0 || processBuffer(buf, end - buf, 1) != 0) {
+    if (trace_enabled) {
+      trace_end("if");
+    }
     return -1;
   }
-  stripspaces(buf);
-  DPRINT("ifEvalpost: %s\n", buf);
+  DLOG(DBG_TRACE, "ifEvalpost: %s\n", buf);
 
+  STATS_ENTER(PH_EXPR, phase);
   *result = evaluate_expression(buf);
+  STATS_LEAVE(phase);
+  if (trace_enabled) {
+    trace_end("if");
+  }
   if (expr_error != EE_OK) {
-    DPRINT("Error evaluating if expression %d\n", expr_error);
+    DPRINTERR("Error evaluating if expression %d\n", expr_error);
     return -1;
   }
 
-  DPRINT("ifEvalResult: %ld\n", *result);
+  DLOG(DBG_TRACE, "ifEvalResult: %ld\n", *result);
 
   return 0;
 }
@@ -243,18 +318,20 @@ int do_include(char *buf, char *end)
   char *strend = buf + strlen(buf) + 1;
   char *fname_start, *fname_end;
   int flag = 0;
+  pptoken_t tok;
 
   if (buf >= end || strend >= end) {
     return -1;  // error
   }
 
-  // Find the start of the filename
-  if ((fname_start = strchr(buf, '<')) != NULL) {
-    fname_start++;
+  // The filename is a string literal or the chars between '<' and '>'
+  char *next = lextoken(buf, end, &tok);
+  if (tokenis(&tok, "<")) {
+    fname_start = tok.start + 1;
     fname_end = strchr(fname_start, '>');
-  } else if ((fname_start = strchr(buf, '\"')) != NULL) {
-    fname_start++;
-    fname_end = strchr(fname_start, '\"');
+  } else if (tok.kind == TK_STRING && *tok.start == '\"' && tok.len >= 2 && *(next - 1) == '\"') {
+    fname_start = tok.start + 1;
+    fname_end = next - 1;
     flag = 1;
   } else {
     return -1;
@@ -273,6 +350,114 @@ int do_include(char *buf, char *end)
 
 
 
+/**
+ * @brief Pushes a new condition on the condition stack.
+ *
+ * @param ifstate 1 if the condition is true, 0 otherwise
+ * @return 0 on success, -1 if out of memory
+ */
+int pushcond(int ifstate)
+{
+  cmdcond_t *tmp = xmalloc(ALLOC_COND, sizeof(cmdcond_t));
+  if (tmp == NULL) {
+    return -1;
+  }
+  tmp->state = COND_IF;
+  tmp->ifstate = ifstate;
+  tmp->prev = cmdcond;
+  cmdcond = tmp;
+  condstate = ifstate;
+  conddepth++;
+  return 0;
+}
+
+
+
+/**
+ * @brief Pops the innermost condition, called for its #endif.
+ *
+ * If the condition is the include guard candidate of the current file, the
+ * line of the #endif is recorded. The guard is valid if no other line follows.
+ * A later condition on the same level is not the guard, the candidate was not
+ * one.
+ */
+void popcond()
+{
+  instream_t *in = getcurrentinstream();
+  if (in != NULL && in->guard != NULL && in->guarddepth == conddepth) {
+    if (in->guardline != 0) {  // the candidate was closed before
+      in->guarddepth = -1;
+    } else {
+      in->guardline = in->sigline;
+    }
+  }
+  cmdcond_t *tmp = cmdcond;
+  cmdcond = cmdcond->prev;
+  xfree(ALLOC_COND, tmp);
+  conddepth--;
+  condstate = 1;
+}
+
+
+
+/**
+ * @brief Releases the conditions left open at the end of the input and the names given by -U.
+ */
+void freecond()
+{
+  while (cmdcond != NULL) {
+    popcond();
+  }
+  for (int i = 0; i < nundefnames; i++) {
+    xfree(ALLOC_MACRO, undefnames[i]);
+  }
+  xfree(ALLOC_MACRO, undefnames);
+  undefnames = NULL;
+  nundefnames = 0;
+}
+
+
+
+/**
+ * @brief Takes the #ifndef of the first line of a file as include guard candidate.
+ *
+ * @param name The macro name of the #ifndef.
+ */
+void guardbegin(char *name)
+{
+  instream_t *in = getcurrentinstream();
+  if (in == NULL || in->sigline != 1 || in->guard != NULL) {
+    return;
+  }
+  pptoken_t tok;
+  lextoken(name, name + strlen(name), &tok);
+  if (tok.kind != TK_IDENT) {
+    return;
+  }
+  in->guard = xmalloc(ALLOC_STREAM, tok.len + 1);
+  if (in->guard == NULL) {
+    return;
+  }
+  memcpy(in->guard, tok.start, tok.len);
+  in->guard[tok.len] = '\0';
+  in->guarddepth = conddepth;
+}
+
+
+
+/**
+ * @brief An #else or #elif of the guard condition invalidates the include guard.
+ */
+void guardelse()
+{
+  instream_t *in = getcurrentinstream();
+  if (in != NULL && in->guarddepth == conddepth) {
+    in->guarddepth = -1;
+  }
+}
+
+
+
 /**
  * @brief processes a cpp command line
  * 
@@ -290,31 +475,45 @@ int processcmdline(char *buf, int size)
   char *start = ++buf;  // skip the '#'
   char *strend = start + strlen(start);
   result_t result;
+  pptoken_t tok, arg;
   static int ifdepth = 0;  // depth of nested if statements in case of ignored commands
 
   if (buf >= end || strend >= end) {
     return -1;  // error
   }
 
-  if (*buf == ' ') {    // skip leading whitespaces
+  buf = lextoken(buf, end, &tok);  // the directive name
+  while (buf < end && ISCHAR(*buf, CH_SPACE)) {  // the arguments follow
     ++buf;
-    ++start;
   }
+  lextoken(buf, end, &arg);  // the first argument
 
-  while (buf < end && *buf != ' ' && *buf != '\n' && *buf != '\0') {  // find the end of the command
-    ++buf;
-  }
-  *buf = '\0';
-
-  cmdtoken_t cmd = getcmdtype(start);
+  cmdtoken_t cmd = getcmdtype(&tok);
   if (cmd == Err) {
     return -1;
   }
+  if (cmd < STATS_DIRECTIVES) {
+    STATS_INC(directives[cmd]);
+  }
   if (cmdcond != NULL) {
     if (condstate == 0) {
       if (cmd == IF || cmd == IFDEF || cmd == IFNDEF) {
         DPRINT("Ignoring if statement\n");
         ifdepth++;
+      } else if (cmd == ELIF && ifdepth == 0) {
+        if (cmdcond->state == COND_ELSE) {
+          DPRINTERR("Error: unexpected elif\n");
+          return -1;
+        }
+        if (!cmdcond->ifstate) {  // no group taken yet
+          if (evalifexpr(buf, end, &result) != 0) {
+            DPRINTERR("Error evaluating if expression\n");
+            return -1;
+          }
+          condstate = cmdcond->ifstate = result != 0;
+        }
+        guardelse();
+        DPRINT("Elif: %d\n", condstate);
       } else if (cmd == ELSE) {
         if (ifdepth > 0) {
           DPRINT("Ignoring else statement\n");
@@ -322,6 +521,7 @@ int processcmdline(char *buf, int size)
           DPRINT("Else: %d\n", cmdcond->ifstate);
           condstate = !cmdcond->ifstate;
           cmdcond->state = COND_ELSE;
+          guardelse();
         }
       } else if (cmd == ENDIF) {
         if (ifdepth > 0) {
@@ -329,42 +529,31 @@ int processcmdline(char *buf, int size)
           ifdepth--;
         } else {
           DPRINT("Endif: %d\n", cmdcond->ifstate);
-          cmdcond_t *tmp = cmdcond;
-          cmdcond = cmdcond->prev;
-          free(tmp);
-          condstate = 1;
+          popcond();
         }
       }
       return 0;
     }
     if (cmdcond->state == COND_IF) {
-      if (cmd == ELIF) {
-        if (evalifexpr(buf + 1, end, &result) != 0) {
-          DPRINT("Error evaluating if expression\n");
-          return -1;
-        }
-        condstate = cmdcond->ifstate = result;
-        DPRINT("Elif: %d\n", cmdcond->ifstate);
+      if (cmd == ELIF) {  // the group before was taken, the rest is skipped
+        condstate = 0;
+        guardelse();
+        DPRINT("Elif: %d\n", condstate);
       } else if (cmd == ELSE) {
         condstate = !cmdcond->ifstate;
         cmdcond->state = COND_ELSE;
+        guardelse();
         DPRINT("Else: %d\n", cmdcond->ifstate);
       } else if (cmd == ENDIF) {
         DPRINT("Endif: %d\n", cmdcond->ifstate);
-        cmdcond_t *tmp = cmdcond;
-        cmdcond = cmdcond->prev;
-        free(tmp);
-        condstate = 1;
+        popcond();
       }
     } else if (cmdcond->state == COND_ELSE) {
       if (cmd == ENDIF) {
-        cmdcond_t *tmp = cmdcond;
-        cmdcond = cmdcond->prev;
-        free(tmp);
-        condstate = 1;
+        popcond();
       }
       if (cmd == ELIF || cmd == ELSE) {
-        DPRINT("Error: unexpected else or elif\n");
+        DPRINTERR("Error: unexpected else or elif\n");
         return -1;
       }
     }
@@ -377,85 +566,82 @@ int processcmdline(char *buf, int size)
       DPRINT("empty cmd\n");
       break;
     case INCLUDE:
-      if (processBuffer(buf, end - buf, 0) != 0) {
+      if (!tokenis(&arg, "<") && arg.kind != TK_STRING && processBuffer(buf, end - buf, 0) != 0) {  // computed include
         return -1;
       }
-      DPRINT("Include: %s\n", buf + 1);
-      if (do_include(buf + 1, end) != 0) {
+      DPRINT("Include: %s\n", buf);
+      if (do_include(buf, end) != 0) {
         return -1;
       }
       break;
     case DEFINE:
-      DPRINT("Define: %s\n", buf + 1);
-      addMacro(buf + 1);
-      // printMacroList();  // @todo remove
+      DPRINT("Define: %s\n", buf);
+      if (addMacro(buf) != 0) {
+        DPRINTERR("Error adding macro\n");
+        return -1;
+      }
       break;
     case UNDEF:
-      DPRINT("Undef: %s\n", buf + 1);
-      deleteMacro(buf + 1);
+      DPRINT("Undef: %s\n", buf);
+      if (arg.kind == TK_IDENT) {
+        arg.start[arg.len] = '\0';
+        deleteMacro(arg.start);
+      }
       break;
     case IF:
-    {
-      cmdcond_t *tmp = malloc(sizeof(cmdcond_t));
-      tmp->state = COND_IF;
-      DPRINT("If: %s\n", buf + 1);
-      if (evalifexpr(buf + 1, end, &result) != 0) {
+      DPRINT("If: %s\n", buf);
+      if (evalifexpr(buf, end, &result) != 0) {
+        return -1;
+      }
+      if (pushcond(result) != 0) {
         return -1;
       }
-      tmp->ifstate = result;
-      tmp->prev = cmdcond;
-      cmdcond = tmp;
-      condstate = tmp->ifstate;
       ifdepth = 0;
       break;
-    }
     case IFDEF:
-    {
-      cmdcond_t *tmp = malloc(sizeof(cmdcond_t));
-      tmp->state = COND_IF;
-      tmp->ifstate = isdefinedMacro(buf + 1, buf + 1 + strlen(buf + 1));
-      tmp->prev = cmdcond;
-      cmdcond = tmp;
-      condstate = tmp->ifstate;
+      if (pushcond(isdefinedMacro(arg.start, arg.start + arg.len)) != 0) {
+        return -1;
+      }
       ifdepth = 0;
-      DPRINT("Ifdef: %s %d\n", buf + 1, tmp->ifstate);
+      DPRINT("Ifdef: %s %d\n", buf, condstate);
       break;
-    }
     case IFNDEF:
-    {
-      cmdcond_t *tmp = malloc(sizeof(cmdcond_t));
-      tmp->state = COND_IF;
-      tmp->ifstate = !isdefinedMacro(buf + 1, buf + 1 + strlen(buf + 1));
-      tmp->prev = cmdcond;
-      cmdcond = tmp;
-      condstate = tmp->ifstate;
+      if (pushcond(!isdefinedMacro(arg.start, arg.start + arg.len)) != 0) {
+        return -1;
+      }
+      guardbegin(buf);
       ifdepth = 0;
-      DPRINT("Ifndef: %s %d\n", buf + 1, tmp->ifstate);
+      DPRINT("Ifndef: %s %d\n", buf, condstate);
       break;
-    }
     case ELSE:
       DPRINT("Else:\n");
       break;
     case ELIF:
-      DPRINT("Elif: %s\n", buf + 1);
+      DPRINT("Elif: %s\n", buf);
       break;
     case ENDIF:
       DPRINT("Endif:\n");
       break;
     case ERROR:
-      DPRINT("Error: %s\n", buf + 1);
+      DPRINT("Error: %s\n", buf);
       break;
     case PRAGMA:
-      DPRINT("Pragma: %s\n", buf + 1);
+      DPRINT("Pragma: %s\n", buf);
+      if (tokenis(&arg, "once")) {
+        instream_t *in = getcurrentinstream();
+        if (in != NULL) {
+          in->header->once = 1;
+        }
+      }
       break;
     case LINE:
-      DPRINT("Line: %s\n", buf + 1);
+      DPRINT("Line: %s\n", buf);
       break;
     case UNKNOWN:
-      DPRINT("Unknown: %s\n", buf + 1);
+      DPRINT("Unknown: %s\n", buf);
       break;
     default:
-      DPRINT("default: %s\n", buf + 1);
+      DPRINT("default: %s\n", buf);
       break;
   }
   return 0;
@@ -463,3 +649,153 @@ int processcmdline(char *buf, int size)
 
 
 
+
+
+
+/**
+ * @brief Evaluates an #if expression in partial mode.
+ *
+ * The expression is evaluated in a copy, so the line can be written as it
+ * is. The known macros are expanded, the names given by -U are 0 and any
+ * other identifier is an unknown value. A malformed expression is unknown,
+ * the directive is kept.
+ *
+ * @param buf The expression.
+ * @param size Size of the buffer the line is in, the copy gets the same size.
+ * @return 1 if true, 0 if false, -1 if unknown.
+ */
+static int evalpartial(const char *buf, int size)
+{
+  char *expr = xmalloc(ALLOC_COND, size);
+  if (expr == NULL) {
+    return -1;
+  }
+  char *end = expr + size - 1;
+  pptoken_t tok;
+  int unknown = 1;
+  result_t result = 0;
+
+  strcpy(expr, buf);
+  if (check_defined(expr, end) == 0 && processBuffer(expr, end - expr, 0) == 0) {
+    for (char *p = expr;;) {
+      char *next = lextoken(p, end, &tok);
+      if (tok.kind == TK_END) {
+        break;
+      }
+      p = tok.kind == TK_IDENT && isundefined(tok.start, tok.len) ? replaceBuf(tok.start, next, end, "0") : next;
+    }
+    result = evaluate_partial(expr, &unknown);
+    unknown |= expr_error != EE_OK;
+  }
+  DLOG(DBG_TRACE, "evalpartial: %s -> %s\n", buf, unknown ? "unknown" : result ? "true" : "false");
+  xfree(ALLOC_COND, expr);
+  return unknown ? -1 : result != 0;
+}
+
+
+
+/**
+ * @brief Processes a directive line in partial mode.
+ *
+ * Only the conditionals are resolved, as far as they depend on known macros.
+ * The directives of a conditional are written if one of its conditions is
+ * unknown, the groups of known false conditions are dropped. Other
+ * directives are written as they are, #include is not followed and #define
+ * and #undef are not executed.
+ *
+ * The line is rewritten in place where it has to: an #elif which becomes the
+ * first condition written is turned into an #if, a known true #elif behind
+ * written conditions into an #else.
+ *
+ * @param buf The whole line, including the '#'.
+ * @param size Size of the buffer.
+ * @return 1 if the line is written, 0 if it is dropped, -1 on error.
+ */
+int partialcmdline(char *buf, int size)
+{
+  assert(buf != NULL);
+  assert(size > 0);
+  char *end = buf + size - 1;
+  pptoken_t tok, arg;
+  static int skipdepth = 0;  // depth of nested conditionals in a dropped group
+
+  char *args = lextoken(buf + 1, end, &tok);  // the directive name
+  lextoken(args, end, &arg);
+  cmdtoken_t cmd = getcmdtype(&tok);
+  if (cmd < STATS_DIRECTIVES) {
+    STATS_INC(directives[cmd]);
+  }
+  if (condstate == 0) {  // in a dropped group
+    if (cmd == IF || cmd == IFDEF || cmd == IFNDEF) {
+      skipdepth++;
+      return 0;
+    }
+    if (skipdepth > 0) {
+      skipdepth -= cmd == ENDIF;
+      return 0;
+    }
+    if (cmd != ELIF && cmd != ELSE && cmd != ENDIF) {
+      return 0;
+    }
+  }
+  if ((cmd == ELIF || cmd == ELSE || cmd == ENDIF) && cmdcond == NULL) {
+    return 1;  // unbalanced, not ours to resolve
+  }
+  if ((cmd == ELIF || cmd == ELSE) && cmdcond->state == COND_ELSE) {
+    DPRINTERR("Error: unexpected else or elif\n");
+    return -1;
+  }
+
+  int state;
+  switch (cmd) {
+    case IF:
+    case IFDEF:
+    case IFNDEF:
+      if (cmd == IF) {
+        state = evalpartial(args, end - args + 1);
+      } else {
+        state = arg.kind == TK_IDENT ? macrostate(arg.start, arg.start + arg.len) : -1;
+        if (cmd == IFNDEF && state >= 0) {
+          state = !state;
+        }
+      }
+      if (pushcond(state == 1) != 0) {
+        return -1;
+      }
+      cmdcond->kept = state < 0;
+      condstate = state != 0;
+      return cmdcond->kept;
+    case ELIF:
+      if (cmdcond->ifstate) {  // a group was taken, the rest is dropped
+        condstate = 0;
+        return 0;
+      }
+      state = evalpartial(args, end - args + 1);
+      condstate = state != 0;
+      if (state == 0) {
+        return 0;
+      }
+      if (state == 1) {
+        cmdcond->ifstate = 1;
+        if (cmdcond->kept) {
+          strcpy(tok.start, "else");
+        }
+        return cmdcond->kept;
+      }
+      if (!cmdcond->kept) {  // elif -> if
+        cmdcond->kept = 1;
+        memmove(tok.start, tok.start + 2, strlen(tok.start + 2) + 1);
+      }
+      return 1;
+    case ELSE:
+      cmdcond->state = COND_ELSE;
+      condstate = !cmdcond->ifstate;
+      return cmdcond->kept && condstate;
+    case ENDIF:
+      state = cmdcond->kept;
+      popcond();
+      return state;
+    default:
+      return 1;
+  }
+}
@@ -19,9 +19,16 @@ typedef enum cmdcondstate {
 
 
 extern int condstate;
+extern int conddepth;
+extern int partialmode;
 
 int iscmdline(char *line);
 int processcmdline(char *buf, int size);
+int partialcmdline(char *buf, int size);
+int addundefined(const char *name);
+int check_defined(char *buf, char *end);
+const char *getcmdname(int cmd);
+void freecond();
 
 
 #endif
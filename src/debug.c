@@ -0,0 +1,239 @@
+/**
+ * @file debug.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief leveled trace points per subsystem, logged to an in-memory ring buffer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Trace points write their message into the next slot of a ring buffer, the
+ * oldest messages are overwritten. A writer reserves its slot with an atomic
+ * increment of the head and publishes it by storing the sequence number
+ * last, so no lock is needed and a slot which is written while the ring is
+ * dumped is skipped. The ring is dumped at exit to stderr or to the file
+ * given by dbg_open().
+ *
+ * The filter is a list of subsystem=level pairs separated by commas, e.g.
+ * "macro=trace,input" or "all=info". A subsystem without level is enabled
+ * at level debug.
+ */
+#define NDEBUG
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include "debug.h"
+#include "alloc.h"
+
+#define DBG_RING    4096   // number of messages kept, a power of two
+#define DBG_MSGLEN  160
+
+
+typedef struct dbgentry {
+  atomic_ulong seq;       /**< index + 1 of the message in the slot, 0 while it is written */
+  long long ns;           /**< time since the first message */
+  const char *file;       /**< source file of the trace point */
+  int line;               /**< source line of the trace point */
+  unsigned char sys;      /**< subsystem */
+  unsigned char level;    /**< level */
+  char msg[DBG_MSGLEN];   /**< formatted message, truncated */
+} dbgentry_t;
+
+
+unsigned char dbg_levels[DBG_SUBSYSTEMS];
+
+static const char *sysnames[DBG_SUBSYSTEMS] = {
+  "main",
+  "input",
+  "directive",
+  "macro",
+  "expr",
+  "header",
+  "token",
+  "alloc",
+  "limits",
+  "report"
+};
+
+static const char *levelnames[] = {
+  "off",
+  "error",
+  "warn",
+  "info",
+  "debug",
+  "trace"
+};
+
+static dbgentry_t ring[DBG_RING];
+static atomic_ulong head = 0;
+static long long dbgstart = 0;
+static char *dumpfname = NULL;
+static int dumpregistered = 0;
+
+
+
+static long long dbgnow()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+
+/**
+ * @brief dumps the ring once, at exit or when main releases everything
+ */
+void dbg_close()
+{
+  FILE *out = stderr;
+  if (dumpregistered != 1) {  // no filter set or already dumped
+    xfree(ALLOC_REPORT, dumpfname);
+    dumpfname = NULL;
+    return;
+  }
+  dumpregistered = 2;
+  if (dumpfname != NULL) {
+    out = fopen(dumpfname, "w");
+    if (out == NULL) {
+      perror(dumpfname);
+    }
+    xfree(ALLOC_REPORT, dumpfname);
+    dumpfname = NULL;
+    if (out == NULL) {
+      return;
+    }
+  }
+  dbg_dump(out);
+  if (out != stderr) {
+    fclose(out);
+  }
+}
+
+
+
+static int lookup(const char *name, int len, const char **names, int count)
+{
+  for (int i = 0; i < count; i++) {
+    if ((int)strlen(names[i]) == len && strncmp(names[i], name, len) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+
+/**
+ * @brief sets the levels of the subsystems and dumps the ring at exit
+ *
+ * @param spec filter, e.g. "macro=trace,input" or "all=info"
+ * @return 0 on success, -1 if the filter can not be parsed
+ */
+int dbg_setfilter(const char *spec)
+{
+  while (*spec != '\0') {
+    int len = strcspn(spec, ",");
+    int namelen = strcspn(spec, "=,");
+    int level = DBG_DEBUG;
+    if (namelen < len) {
+      level = lookup(spec + namelen + 1, len - namelen - 1, levelnames, DBG_TRACE + 1);
+      if (level < 0) {
+        fprintf(stderr, "Unknown debug level: %.*s\n", len - namelen - 1, spec + namelen + 1);
+        return -1;
+      }
+    }
+    if (namelen == 3 && strncmp(spec, "all", 3) == 0) {
+      memset(dbg_levels, level, sizeof(dbg_levels));
+    } else {
+      int sys = lookup(spec, namelen, sysnames, DBG_SUBSYSTEMS);
+      if (sys < 0) {
+        fprintf(stderr, "Unknown debug subsystem: %.*s\n", namelen, spec);
+        return -1;
+      }
+      dbg_levels[sys] = level;
+    }
+    spec += len;
+    if (*spec == ',') {
+      spec++;
+    }
+  }
+  if (!dumpregistered) {
+    dbgstart = dbgnow();
+    atexit(dbg_close);
+    dumpregistered = 1;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief dumps the ring to fname at exit instead of stderr
+ *
+ * @param fname name of the file
+ * @return 0 on success, -1 if out of memory
+ */
+int dbg_open(const char *fname)
+{
+  xfree(ALLOC_REPORT, dumpfname);
+  dumpfname = xstrdup(ALLOC_REPORT, fname);
+  return dumpfname != NULL ? 0 : -1;
+}
+
+
+
+/**
+ * @brief records a message in the ring, called by the trace point macros
+ */
+void dbg_log(dbgsys_t sys, dbglevel_t level, const char *file, int line, const char *fmt, ...)
+{
+  unsigned long idx = atomic_fetch_add_explicit(&head, 1, memory_order_relaxed);
+  dbgentry_t *e = &ring[idx % DBG_RING];
+  va_list ap;
+
+  atomic_store_explicit(&e->seq, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  e->ns = dbgnow() - dbgstart;
+  e->file = file;
+  e->line = line;
+  e->sys = sys;
+  e->level = level;
+  va_start(ap, fmt);
+  vsnprintf(e->msg, sizeof(e->msg), fmt, ap);
+  va_end(ap);
+  atomic_store_explicit(&e->seq, idx + 1, memory_order_release);
+}
+
+
+
+/**
+ * @brief prints the messages in the ring, oldest first
+ *
+ * @param out stream to print to
+ */
+void dbg_dump(FILE *out)
+{
+  unsigned long end = atomic_load_explicit(&head, memory_order_acquire);
+  unsigned long idx = end > DBG_RING ? end - DBG_RING : 0;
+
+  if (idx > 0) {
+    fprintf(out, "*** %lu debug messages lost\n", idx);
+  }
+  for (; idx < end; idx++) {
+    dbgentry_t *e = &ring[idx % DBG_RING];
+    if (atomic_load_explicit(&e->seq, memory_order_acquire) != idx + 1) {
+      continue;
+    }
+    int len = strlen(e->msg);
+    if (len > 0 && e->msg[len - 1] == '\n') {
+      len--;
+    }
+    fprintf(out, "%12.3f %-9s %-5s %s:%d: %.*s\n", e->ns / 1e3, sysnames[e->sys], levelnames[e->level],
+            e->file, e->line, len, e->msg);
+  }
+}
@@ -1,12 +1,16 @@
 /**
  * @file debug.h
  * @author Thomas Boos (tboos70@gmail.com)
- * @brief 
+ * @brief leveled trace points per subsystem, logged to an in-memory ring buffer
  * @version 0.1
  * @date 2024-08-07
- * 
+ *
  * @copyright Copyright (c) 2024
- * 
+ *
+ * A trace point is only recorded if its level is enabled for the subsystem
+ * of the file at runtime (dbg_setfilter()), a disabled trace point costs one
+ * compare. A file selects its subsystem by defining DBG_SUBSYSTEM before it
+ * includes debug.h. Compiling with -DNTRACE removes all trace points.
  */
 
 #ifndef DEBUG_H  // NOLINT
@@ -15,15 +19,57 @@
 #include <stdio.h>
 #include <assert.h>
 
-#ifdef NDEBUG
-#define DPRINT(fmt, ...)  do { } while (0)
-#define DPRINTERR(fmt, ...)  do { } while (0)
+typedef enum dbgsys {
+  DBG_MAIN,
+  DBG_INPUT,
+  DBG_DIRECTIVE,
+  DBG_MACRO,
+  DBG_EXPR,
+  DBG_HEADER,
+  DBG_TOKEN,
+  DBG_ALLOC,
+  DBG_LIMITS,
+  DBG_REPORT,
+  DBG_SUBSYSTEMS
+} dbgsys_t;
+
+typedef enum dbglevel {
+  DBG_OFF,
+  DBG_ERROR,
+  DBG_WARN,
+  DBG_INFO,
+  DBG_DEBUG,
+  DBG_TRACE
+} dbglevel_t;
+
+
+extern unsigned char dbg_levels[DBG_SUBSYSTEMS];
+
+int dbg_setfilter(const char *spec);
+int dbg_open(const char *fname);
+void dbg_close();
+void dbg_log(dbgsys_t sys, dbglevel_t level, const char *file, int line, const char *fmt, ...)
+  __attribute__((format(printf, 5, 6)));
+void dbg_dump(FILE *out);
+
+#ifndef DBG_SUBSYSTEM
+#define DBG_SUBSYSTEM DBG_MAIN
+#endif
+
+#ifdef NTRACE
+#define DLOG(level, ...)  do { } while (0)
 #define D(statement)
 #else
-#define DPRINT(fmt, ...)  do { fprintf(stderr, fmt __VA_OPT__( , ) __VA_ARGS__); } while (0)
-#define DPRINTERR(fmt, ...)  \
-  do { fprinf(stderr, "%s[%s]: ", __FILE__, __LINE__); fprintf(stderr, fmt __VA_OPT__( , ) __VA_ARGS__); } while (0)
-#define D(statement)  statement;
+#define DLOG(level, ...)  \
+  do { \
+    if (__builtin_expect(dbg_levels[DBG_SUBSYSTEM] >= (level), 0)) { \
+      dbg_log(DBG_SUBSYSTEM, level, __FILE__, __LINE__, __VA_ARGS__); \
+    } \
+  } while (0)
+#define D(statement)  if (dbg_levels[DBG_SUBSYSTEM] >= DBG_DEBUG) { statement; }
 #endif
 
+#define DPRINT(...)  DLOG(DBG_DEBUG, __VA_ARGS__)
+#define DPRINTERR(...)  DLOG(DBG_ERROR, __VA_ARGS__)
+
 #endif  // DEBUG_H  // NOLINT
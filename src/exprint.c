@@ -25,15 +25,25 @@
  * 11. &&
  * 12. ||
  * 13. ?:
+ *
+ * The expression is read as preprocessing tokens, see token.h.
+ *
+ * evaluate_partial() evaluates with three values: an identifier left in the
+ * expression is an unknown value instead of an error. A result depending on
+ * an unknown value is unknown, except where the known operands decide it,
+ * e.g. 0 && x, 1 || x or x ? 2 : 2.
  */
 
-#include <ctype.h>
+#include <string.h>
 
 #include "exprint.h"
+#include "token.h"
 
 #ifndef TESTMAIN
-#define FENTRY(param)
-#define FEXIT(result, left)
+#define DBG_SUBSYSTEM DBG_EXPR
+#include "debug.h"
+#define FENTRY(param) DLOG(DBG_TRACE, "Entering %s param \"%s\"\n", __func__, param)
+#define FEXIT(result, left) DLOG(DBG_TRACE, "Exiting %s with result %ld \"%s\"\n", __func__, result, left)
 #else
 #include <stdio.h>
 #define FENTRY(param) printf("Entering %s param \"%s\"\n", __func__, param)
@@ -42,6 +52,7 @@
 
 // Function prototypes
 result_t evaluate_expression(const char *expr);
+result_t evaluate_partial(const char *expr, int *isunknown);
 result_t parse_ternary(const char **expr);
 result_t parse_logical_or(const char **expr);
 result_t parse_logical_and(const char **expr);
@@ -59,29 +70,66 @@ result_t parse_number(const char **expr);
 result_t parse_char_constant(const char **expr);
 
 int expr_error = 0;
+static const char *expr_end;  // end of the expression
+static int partial = 0;       // identifiers are unknown values
+static int unknown = 0;       // the value just parsed is unknown
+
+// Lexes the next token of the expression, without moving past it
+static const char *peek(const char **expr, pptoken_t *tok) {
+  return lextoken((char *)*expr, (char *)expr_end, tok);
+}
+
+// Moves past the next token, if it is the punctuator op
+static int accept(const char **expr, const char *op) {
+  pptoken_t tok;
+  const char *next = peek(expr, &tok);
+  if (tok.kind != TK_PUNCT || !tokenis(&tok, op)) {
+    return 0;
+  }
+  *expr = next;
+  return 1;
+}
 
 // Main evaluation function
 result_t evaluate_expression(const char *expr) {
   expr_error = 0;
+  unknown = 0;
+  expr_end = expr + strlen(expr);
   return parse_ternary(&expr);
 }
 
+// Evaluation with unknown identifiers, *isunknown is set if the result depends on them
+result_t evaluate_partial(const char *expr, int *isunknown) {
+  partial = 1;
+  result_t result = evaluate_expression(expr);
+  partial = 0;
+  *isunknown = unknown;
+  return result;
+}
+
 // Parsing functions
 result_t parse_ternary(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_logical_or(expr);
-  if (**expr == '?') {
-    (*expr)++;
+  int unk = unknown;
+  if (accept(expr, "?")) {
     result_t true_expr = parse_ternary(expr);
-    if (**expr == ':') {
-      (*expr)++;
+    int true_unk = unknown;
+    if (accept(expr, ":")) {
       result_t false_expr = parse_ternary(expr);
-      result = result ? true_expr : false_expr;
+      if (!unk) {
+        unk = result ? true_unk : unknown;
+        result = result ? true_expr : false_expr;
+      } else if (!true_unk && !unknown && true_expr == false_expr) {  // both branches are the same
+        unk = 0;
+        result = true_expr;
+      }
     } else {  // Error handling for missing colon
       expr_error = EE_MISSINGCOLON;
       result = 0;  // Indicate an error
     }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -89,11 +137,18 @@ result_t parse_ternary(const char **expr) {
 result_t parse_logical_or(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_logical_and(expr);
-  while (**expr == '|' && *(*expr + 1) == '|') {
-    (*expr) += 2;
-    result_t rhs = parse_ternary(expr);
-    result = result || rhs;
+  int unk = unknown;
+  while (accept(expr, "||")) {
+    result_t rhs = parse_logical_and(expr);
+    if ((!unk && result) || (!unknown && rhs)) {  // a known true operand decides
+      result = 1;
+      unk = 0;
+    } else {
+      result = 0;
+      unk |= unknown;
+    }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -101,11 +156,18 @@ result_t parse_logical_or(const char **expr) {
 result_t parse_logical_and(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_bitwise_or(expr);
-  while (**expr == '&' && *(*expr + 1) == '&') {
-    (*expr) += 2;
-    result_t rhs = parse_ternary(expr);
-    result = result && rhs;
+  int unk = unknown;
+  while (accept(expr, "&&")) {
+    result_t rhs = parse_bitwise_or(expr);
+    if ((!unk && !result) || (!unknown && !rhs)) {  // a known false operand decides
+      result = 0;
+      unk = 0;
+    } else {
+      result = 1;
+      unk |= unknown;
+    }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -113,11 +175,13 @@ result_t parse_logical_and(const char **expr) {
 result_t parse_bitwise_or(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_bitwise_xor(expr);
-  while (**expr == '|' && *(*expr + 1) != '|') {
-    (*expr)++;
-    result_t rhs = parse_ternary(expr);
+  int unk = unknown;
+  while (accept(expr, "|")) {
+    result_t rhs = parse_bitwise_xor(expr);
+    unk |= unknown;
     result |= rhs;
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -125,11 +189,13 @@ result_t parse_bitwise_or(const char **expr) {
 result_t parse_bitwise_xor(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_bitwise_and(expr);
-  while (**expr == '^') {
-    (*expr)++;
-    result_t rhs = parse_ternary(expr);
+  int unk = unknown;
+  while (accept(expr, "^")) {
+    result_t rhs = parse_bitwise_and(expr);
+    unk |= unknown;
     result ^= rhs;
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -137,11 +203,13 @@ result_t parse_bitwise_xor(const char **expr) {
 result_t parse_bitwise_and(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_equality(expr);
-  while (**expr == '&' && *(*expr + 1) != '&') {
-    (*expr)++;
-    result_t rhs = parse_ternary(expr);
+  int unk = unknown;
+  while (accept(expr, "&")) {
+    result_t rhs = parse_equality(expr);
+    unk |= unknown;
     result &= rhs;
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -149,16 +217,21 @@ result_t parse_bitwise_and(const char **expr) {
 result_t parse_equality(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_relational(expr);
-  while (**expr == '=' || **expr == '!') {
-    char op = **expr;
-    (*expr)++;
-    if (**expr == '=') {
-      (*expr)++;
-      result_t rhs = parse_ternary(expr);
-      if (op == '=') result = result == rhs;
-      else if (op == '!') result = result != rhs;
+  int unk = unknown;
+  for (;;) {
+    if (accept(expr, "==")) {
+      result_t rhs = parse_relational(expr);
+      unk |= unknown;
+      result = result == rhs;
+    } else if (accept(expr, "!=")) {
+      result_t rhs = parse_relational(expr);
+      unk |= unknown;
+      result = result != rhs;
+    } else {
+      break;
     }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -166,20 +239,29 @@ result_t parse_equality(const char **expr) {
 result_t parse_relational(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_shift(expr);
-  while (**expr == '<' || **expr == '>') {
-    char op = **expr;
-    (*expr)++;
-    if (**expr == '=') {
-      (*expr)++;
-      result_t rhs = parse_ternary(expr);
-      if (op == '<') result = result <= rhs;
-      else if (op == '>') result = result >= rhs;
+  int unk = unknown;
+  for (;;) {
+    if (accept(expr, "<=")) {
+      result_t rhs = parse_shift(expr);
+      unk |= unknown;
+      result = result <= rhs;
+    } else if (accept(expr, ">=")) {
+      result_t rhs = parse_shift(expr);
+      unk |= unknown;
+      result = result >= rhs;
+    } else if (accept(expr, "<")) {
+      result_t rhs = parse_shift(expr);
+      unk |= unknown;
+      result = result < rhs;
+    } else if (accept(expr, ">")) {
+      result_t rhs = parse_shift(expr);
+      unk |= unknown;
+      result = result > rhs;
     } else {
-      result_t rhs = parse_ternary(expr);
-      if (op == '<') result = result < rhs;
-      else if (op == '>') result = result > rhs;
+      break;
     }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -187,19 +269,21 @@ result_t parse_relational(const char **expr) {
 result_t parse_shift(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_additive(expr);
-  while (**expr == '<' || **expr == '>') {
-    char op = **expr;
-    (*expr)++;
-    if (**expr == op) {
-      (*expr)++;
-      result_t rhs = parse_ternary(expr);
-      if (op == '<') result <<= rhs;
-      else if (op == '>') result >>= rhs;
+  int unk = unknown;
+  for (;;) {
+    if (accept(expr, "<<")) {
+      result_t rhs = parse_additive(expr);
+      unk |= unknown;
+      result <<= rhs;
+    } else if (accept(expr, ">>")) {
+      result_t rhs = parse_additive(expr);
+      unk |= unknown;
+      result >>= rhs;
     } else {
-      (*expr)--;
       break;
     }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -207,13 +291,16 @@ result_t parse_shift(const char **expr) {
 result_t parse_additive(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_multiplicative(expr);
-  while (**expr == '+' || **expr == '-') {
-    char op = **expr;
-    (*expr)++;
-    result_t rhs = parse_ternary(expr);
+  int unk = unknown;
+  for (;;) {
+    char op = accept(expr, "+") ? '+' : accept(expr, "-") ? '-' : 0;
+    if (op == 0) break;
+    result_t rhs = parse_multiplicative(expr);
+    unk |= unknown;
     if (op == '+') result += rhs;
     else if (op == '-') result -= rhs;
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -221,21 +308,28 @@ result_t parse_additive(const char **expr) {
 result_t parse_multiplicative(const char **expr) {
   FENTRY(*expr);
   result_t result = parse_unary(expr);
-  while (**expr == '*' || **expr == '/' || **expr == '%') {
-    char op = **expr;
-    (*expr)++;
-    result_t rhs = parse_ternary(expr);
-    if (op == '*') result *= rhs;
-    else if (op == '%') result %= rhs;
-    else if (op == '/') {  // NOLINT
-      if (rhs == 0) {  // Error handling for division by zero
-        expr_error = EE_DIVBYZERO;
-        result = 0;  // Indicate an error
-        break;
+  int unk = unknown;
+  for (;;) {
+    char op = accept(expr, "*") ? '*' : accept(expr, "/") ? '/' : accept(expr, "%") ? '%' : 0;
+    if (op == 0) break;
+    result_t rhs = parse_unary(expr);
+    unk |= unknown;
+    if (op == '*') {
+      result *= rhs;
+    } else if (rhs == 0) {  // Error handling for division by zero
+      if (unknown) {  // the value of an unknown divisor is not used
+        continue;
       }
+      expr_error = EE_DIVBYZERO;
+      result = 0;  // Indicate an error
+      break;
+    } else if (op == '%') {
+      result %= rhs;
+    } else {
       result /= rhs;
     }
   }
+  unknown = unk;
   FEXIT(result, *expr);
   return result;
 }
@@ -243,10 +337,12 @@ result_t parse_multiplicative(const char **expr) {
 result_t parse_unary(const char **expr) {
   FENTRY(*expr);
   result_t result = 0;
-  if (**expr == '+' || **expr == '-' || **expr == '!' || **expr == '~') {
-    char op = **expr;
-    (*expr)++;
-    result_t rhs = parse_primary(expr);
+  pptoken_t tok;
+  const char *next = peek(expr, &tok);
+  if (tok.kind == TK_PUNCT && tok.len == 1 && strchr("+-!~", *tok.start) != NULL) {
+    char op = *tok.start;
+    *expr = next;
+    result_t rhs = parse_unary(expr);
     if (op == '+') result = rhs;
     else if (op == '-') result = -rhs;
     else if (op == '!') result = !rhs;
@@ -261,20 +357,35 @@ result_t parse_unary(const char **expr) {
 result_t parse_primary(const char **expr) {
   FENTRY(*expr);
   result_t result;
-  while (isspace(**expr)) (*expr)++;
-  if (**expr == '(') {
-    (*expr)++;
+  pptoken_t tok;
+  const char *next = peek(expr, &tok);
+  unknown = 0;
+  if (accept(expr, "(")) {
     result = parse_ternary(expr);
-    if (**expr == ')') {
-      (*expr)++;
-    } else {  // Error handling for missing closing parenthesis
+    if (!accept(expr, ")")) {  // Error handling for missing closing parenthesis
       expr_error = EE_MISSINGPAREN;
       result = 0;  // Indicate an error
     }
-  } else if (isdigit(**expr)) {
+  } else if (tok.kind == TK_NUMBER && ISCHAR(*tok.start, CH_DIGIT)) {
     result = parse_number(expr);
-  } else if (**expr == '\'') {
+  } else if (tok.kind == TK_CHAR) {
     result = parse_char_constant(expr);
+  } else if (partial && tok.kind == TK_IDENT) {  // unknown, with the operand of defined or the arguments
+    int defined = tokenis(&tok, "defined");
+    *expr = next;
+    next = peek(expr, &tok);
+    if (defined && tok.kind == TK_IDENT) {  // defined name
+      *expr = next;
+    } else if (tokenis(&tok, "(")) {
+      int depth = 0;
+      do {
+        depth += tokenis(&tok, "(") - tokenis(&tok, ")");
+        *expr = next;
+        next = peek(expr, &tok);
+      } while (depth > 0 && tok.kind != TK_END);
+    }
+    unknown = 1;
+    result = 0;
   } else {  // Error handling for unexpected character
     expr_error = EE_UNEXPECTEDCHAR;
     result = 0;  // Indicate an error
@@ -283,46 +394,92 @@ result_t parse_primary(const char **expr) {
   return result;
 }
 
+// Value of a hexadecimal digit
+static int hexdigit(char c) {
+  return ISCHAR(c, CH_DIGIT) ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
 result_t parse_number(const char **expr) {
   FENTRY(*expr);
   result_t result = 0;
   int base = 10;
-  if (**expr == '0') {
-    (*expr)++;
-    if (**expr == 'x' || **expr == 'X') {
+  pptoken_t tok;
+  const char *next = peek(expr, &tok);
+  const char *p = tok.start;
+  if (*p == '0') {
+    p++;
+    if (*p == 'x' || *p == 'X') {
       base = 16;
-      (*expr)++;
-    } else if (**expr == 'b' || **expr == 'B') {
+      p++;
+    } else if (*p == 'b' || *p == 'B') {
       base = 2;
-      (*expr)++;
+      p++;
     } else {
       base = 8;
     }
   }
-  while (isxdigit(**expr)) {
-    int digit = isdigit(**expr) ? **expr - '0' : tolower(**expr) - 'a' + 10;
+  for (; p < next && ISCHAR(*p, CH_XDIGIT); p++) {
+    int digit = hexdigit(*p);
     if (digit >= base) {  // Error handling for invalid digit
       result = 0;
       expr_error = EE_INVALDIGIT;
       break;
     }
     result = result * base + digit;
-    (*expr)++;
   }
-  if (**expr == 'u' || **expr == 'U' || **expr == 'l' || **expr == 'L') (*expr)++;
+  for (; p < next && expr_error == EE_OK; p++) {  // only the suffixes u and l may follow
+    if (strchr("uUlL", *p) == NULL) {
+      result = 0;
+      expr_error = EE_INVALDIGIT;
+    }
+  }
+  *expr = next;
   FEXIT(result, *expr);
   return result;
 }
 
+// Value of the escape sequence at p, behind the backslash
+static result_t parse_escape(const char **p, const char *end) {
+  const char *escapes = "a\ab\bf\fn\nr\rt\tv\v";
+  char c = *(*p)++;
+  result_t result = 0;
+  if (c == 'x') {
+    while (*p < end && ISCHAR(**p, CH_XDIGIT)) {
+      result = result * 16 + hexdigit(**p);
+      (*p)++;
+    }
+    return result;
+  }
+  if (c >= '0' && c <= '7') {
+    result = c - '0';
+    for (int i = 1; i < 3 && *p < end && **p >= '0' && **p <= '7'; i++) {
+      result = result * 8 + *(*p)++ - '0';
+    }
+    return result;
+  }
+  for (const char *e = escapes; *e != '\0'; e += 2) {
+    if (*e == c) {
+      return e[1];
+    }
+  }
+  return c;  // \' \" \\ \?
+}
+
 result_t parse_char_constant(const char **expr) {
   FENTRY(*expr);
   result_t result = 0;
-  if (**expr == '\'') {
-    (*expr)++;
-    result = **expr;
-    (*expr)++;
-    if (**expr == '\'') (*expr)++;
+  pptoken_t tok;
+  const char *next = peek(expr, &tok);
+  const char *p = strchr(tok.start, '\'') + 1, *end = next - 1;  // behind the prefix
+  if (p < end) {
+    if (*p == '\\') {
+      p++;
+      result = parse_escape(&p, end);
+    } else {
+      result = (tok.start == p - 1) ? (char)*p : (unsigned char)*p;  // plain char constants are signed
+    }
   }
+  *expr = next;
   FEXIT(result, *expr);
   return result;
 }
@@ -343,7 +500,7 @@ int main() {
   printf("Result of test expression 1: %ld, %ld\n", result1, -123L&321L);  // Expected: 100
   printf("Result of test expression 2: %ld\n", result2);  // Expected: -1
   printf("Result of test expression 3: %ld\n", result3);  // Expected: 10
-  printf("Result of test expression 4: %ld\n", result4);  // Expected: 1
+  printf("Result of test expression 4: %ld\n", result4);  // Expected: 0
 
   return 0;
 }
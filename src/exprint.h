@@ -14,6 +14,7 @@
 typedef long result_t;  // NOLINT
 
 result_t evaluate_expression(const char *expr);
+result_t evaluate_partial(const char *expr, int *isunknown);
 
 // expression error codes
 enum {
@@ -0,0 +1,207 @@
+/**
+ * @file header.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief registry of included files, #pragma once, include guards and cost report
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every file opened by newinstream() gets a header_t record, looked up by
+ * its path name. The record remembers #pragma once and a detected include
+ * guard, so newinstream() can skip the file without opening it again.
+ *
+ * If headerreport_enabled is set, newinstream()/releaseinstream() also
+ * account the bytes lexed and the time spent per file. header_report()
+ * writes the records sorted by inclusive time as tab separated table. If
+ * the report file already exists, its numbers are added first, so a batch
+ * of runs can be aggregated into one report.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_HEADER
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "debug.h"
+#include "header.h"
+#include "alloc.h"
+
+#define HEADER_BUCKETS  4096
+
+
+int headerreport_enabled = 0;
+
+static header_t *buckets[HEADER_BUCKETS];
+static int headers = 0;
+
+
+
+static unsigned hashpath(const char *path)
+{
+  unsigned h = 2166136261u;
+  while (*path != '\0') {
+    h = (h ^ (unsigned char)*path++) * 16777619u;
+  }
+  return h;
+}
+
+
+
+long long header_now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+
+/**
+ * @brief finds the record of a file, a new record is created if there is none
+ *
+ * @param path path name of the file
+ * @return pointer to the record, NULL if out of memory
+ */
+header_t *header_get(const char *path)
+{
+  unsigned idx = hashpath(path) % HEADER_BUCKETS;
+  header_t *hdr;
+
+  for (hdr = buckets[idx]; hdr != NULL; hdr = hdr->next) {
+    if (strcmp(hdr->path, path) == 0) {
+      return hdr;
+    }
+  }
+  hdr = xcalloc(ALLOC_STREAM, 1, sizeof(header_t));
+  if (hdr == NULL) {
+    return NULL;
+  }
+  hdr->path = xstrdup(ALLOC_PATH, path);
+  if (hdr->path == NULL) {
+    xfree(ALLOC_STREAM, hdr);
+    return NULL;
+  }
+  hdr->next = buckets[idx];
+  buckets[idx] = hdr;
+  headers++;
+  DPRINT("New header record %s\n", path);
+  return hdr;
+}
+
+
+
+/**
+ * @brief releases all records
+ */
+void header_free()
+{
+  for (int i = 0; i < HEADER_BUCKETS; i++) {
+    while (buckets[i] != NULL) {
+      header_t *hdr = buckets[i];
+      buckets[i] = hdr->next;
+      xfree(ALLOC_STREAM, hdr->guard);
+      xfree(ALLOC_PATH, hdr->path);
+      xfree(ALLOC_STREAM, hdr);
+    }
+  }
+  headers = 0;
+}
+
+
+
+/**
+ * @brief adds the numbers of an existing report to the records
+ */
+static void mergereport(FILE *f)
+{
+  char line[4096];
+  while (fgets(line, sizeof(line), f) != NULL) {
+    unsigned long opens, guardskips, onceskips, bytes;
+    double inclms, exclms;
+    int pos = 0;
+    if (line[0] == '#') {
+      continue;
+    }
+    if (sscanf(line, "%lu\t%lu\t%lu\t%lu\t%lf\t%lf\t%n", &opens, &guardskips, &onceskips, &bytes,
+               &inclms, &exclms, &pos) != 6 || pos == 0) {
+      continue;
+    }
+    line[strcspn(line, "\n")] = '\0';
+    header_t *hdr = header_get(line + pos);
+    if (hdr == NULL) {
+      continue;
+    }
+    hdr->opens += opens;
+    hdr->guardskips += guardskips;
+    hdr->onceskips += onceskips;
+    hdr->bytes += bytes;
+    hdr->inclns += inclms * 1e6;
+    hdr->exclns += exclms * 1e6;
+  }
+}
+
+
+
+static int cmpheader(const void *a, const void *b)
+{
+  const header_t *x = *(header_t * const *)a, *y = *(header_t * const *)b;
+  if (x->inclns != y->inclns) {
+    return x->inclns < y->inclns ? 1 : -1;
+  }
+  return strcmp(x->path, y->path);
+}
+
+
+
+/**
+ * @brief writes the header cost report, merged with an existing report in fname
+ *
+ * @param fname name of the report file, or NULL for stderr
+ * @return 0 on success, -1 on error
+ */
+int header_report(const char *fname)
+{
+  FILE *out = stderr;
+
+  if (fname != NULL) {
+    FILE *f = fopen(fname, "r");
+    if (f != NULL) {
+      mergereport(f);
+      fclose(f);
+    }
+  }
+
+  header_t **sorted = xmalloc(ALLOC_REPORT, sizeof(header_t *) * (headers + 1));
+  if (sorted == NULL) {
+    return -1;
+  }
+  int n = 0;
+  for (int i = 0; i < HEADER_BUCKETS; i++) {
+    for (header_t *hdr = buckets[i]; hdr != NULL; hdr = hdr->next) {
+      sorted[n++] = hdr;
+    }
+  }
+  qsort(sorted, n, sizeof(header_t *), cmpheader);
+
+  if (fname != NULL) {
+    out = fopen(fname, "w");
+    if (out == NULL) {
+      perror(fname);
+      xfree(ALLOC_REPORT, sorted);
+      return -1;
+    }
+  }
+  fprintf(out, "# opens\tguard skips\tonce skips\tbytes\tincl ms\texcl ms\tpath\n");
+  for (int i = 0; i < n; i++) {
+    header_t *hdr = sorted[i];
+    fprintf(out, "%lu\t%lu\t%lu\t%lu\t%.3f\t%.3f\t%s\n", hdr->opens, hdr->guardskips, hdr->onceskips,
+            hdr->bytes, hdr->inclns / 1e6, hdr->exclns / 1e6, hdr->path);
+  }
+  if (out != stderr) {
+    fclose(out);
+  }
+  xfree(ALLOC_REPORT, sorted);
+  return 0;
+}
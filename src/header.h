@@ -0,0 +1,36 @@
+/**
+ * @file header.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief registry of included files, #pragma once, include guards and cost report
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef HEADER_H
+#define HEADER_H
+
+typedef struct header {
+  struct header *next;    /**< next header in the hash chain */
+  char *path;             /**< path name as found by checkpath() */
+  char *guard;            /**< include guard macro, or NULL if none detected */
+  int once;               /**< 1 if #pragma once was seen */
+  unsigned long opens;    /**< number of times the file was opened */
+  unsigned long guardskips; /**< includes skipped because the guard macro was defined */
+  unsigned long onceskips;  /**< includes skipped because of #pragma once */
+  unsigned long bytes;    /**< bytes lexed from the file */
+  long long inclns;       /**< time including nested includes */
+  long long exclns;       /**< time excluding nested includes */
+} header_t;
+
+
+extern int headerreport_enabled;
+
+header_t *header_get(const char *path);
+long long header_now();
+int header_report(const char *fname);
+void header_free();
+
+#endif  // HEADER_H
@@ -9,15 +9,21 @@
  * 
  */
 #define NDEBUG
+#define DBG_SUBSYSTEM DBG_INPUT
 
-#include <ctype.h>
-#include <errno.h>
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
 
 #include "debug.h"
 #include "input.h"
+#include "stats.h"
+#include "trace.h"
+#include "header.h"
+#include "token.h"
+#include "macro.h"
+#include "alloc.h"
+#include "bounds.h"
 
 
 
@@ -38,10 +44,56 @@ instream_t *getcurrentinstream()
 
 
 
+/**
+ * @brief Returns the name of the file of a stream as a string literal.
+ *
+ * The literal is made on the first call and kept with the stream, so
+ * __FILE__ is formatted once per file.
+ *
+ * @param in The stream.
+ * @return The literal, NULL if out of memory.
+ */
+const char *getfileliteral(instream_t *in)
+{
+  if (in->fileliteral == NULL) {
+    char *literal = xmalloc(ALLOC_STREAM, 2 * strlen(in->fname) + 3);
+    if (literal == NULL) {
+      return NULL;
+    }
+    char *out = literal;
+    *out++ = '"';
+    for (const char *p = in->fname; *p != '\0'; p++) {
+      if (*p == '"' || *p == '\\') {
+        *out++ = '\\';
+      }
+      *out++ = *p;
+    }
+    *out++ = '"';
+    *out = '\0';
+    in->fileliteral = literal;
+  }
+  return in->fileliteral;
+}
+
+
+
+/**
+ * @brief Returns the number of the line read last from a stream.
+ *
+ * The newline ending the line is already read, unless it is the last line of
+ * the file and has none.
+ */
+int getlinenumber(instream_t *in)
+{
+  return in->eof ? in->line : in->line - 1;
+}
+
+
+
 int addsearchdir(const char *path)
 {
   assert(path != NULL);
-  sdir_t *dir = malloc(sizeof(sdir_t));
+  sdir_t *dir = xmalloc(ALLOC_PATH, sizeof(sdir_t));
   if (dir == NULL) {
     return -1;
   }
@@ -58,7 +110,7 @@ int initsearchdirs()
 {
   char *cpath = getenv("CPATH");
   if (cpath == NULL) {
-    printf("CPATH not set\n");
+    fprintf(stderr, "CPATH not set\n");
     return 0;
   }
 
@@ -76,19 +128,39 @@ int initsearchdirs()
 
 
 
+/**
+ * @brief releases all open streams and the search directories
+ */
+void releaseinput()
+{
+  while (currentinstream != NULL) {
+    releaseinstream(currentinstream);
+  }
+  while (sdirs != NULL) {
+    sdir_t *dir = sdirs;
+    sdirs = dir->next;
+    xfree(ALLOC_PATH, dir);
+  }
+}
+
+
+
 char *checkpath(const char *fname, int flag)
 {
   if (fname == NULL) {
     return NULL;
   }
   // @todo: if original source file is not in current directory, add path to fname
-  if (flag != 0 && access(fname, R_OK) == 0) {
-    return strdup(fname);
+  if (flag != 0) {
+    STATS_INC(probes);
+    if (access(fname, R_OK) == 0) {
+      return xstrdup(ALLOC_PATH, fname);
+    }
   }
 
   sdir_t *dir = sdirs;
   while (dir != NULL) {
-    char *pathname = malloc(strlen(dir->path) + strlen(fname) + 2);
+    char *pathname = xmalloc(ALLOC_PATH, strlen(dir->path) + strlen(fname) + 2);
     if (pathname == NULL) {
       return NULL;
     }
@@ -99,10 +171,11 @@ char *checkpath(const char *fname, int flag)
     strcat(pathname, fname);
     // cppcheck-suppress syntaxError
     // DPRINT("Checking %s\n", pathname);
+    STATS_INC(probes);
     if (access(pathname, R_OK) == 0) {
       return pathname;
     }
-    free(pathname);
+    xfree(ALLOC_PATH, pathname);
     dir = dir->next;
   }
   return NULL;
@@ -116,19 +189,133 @@ void releaseinstream(instream_t *in)
     return;
   }
   DPRINT("Releasing current instream '%s'\n", in->fname);
-  if (in->file != NULL) {
-    fclose(in->file);
+  if (in->text != NULL) {
+    header_t *hdr = in->header;
+    if (headerreport_enabled) {
+      long long incl = header_now() - in->opened;
+      hdr->inclns += incl;
+      hdr->exclns += incl - in->childns;
+      hdr->bytes += in->len + 2 * in->nsplices;
+      if (in->parent != NULL) {
+        in->parent->childns += incl;
+      }
+    }
+    if (in->guard != NULL && in->guarddepth >= 0 && in->guardline == in->sigline) {
+      DPRINT("Include guard of '%s' is %s\n", in->fname, in->guard);
+      xfree(ALLOC_STREAM, hdr->guard);
+      hdr->guard = in->guard;
+      in->guard = NULL;
+    }
+    if (trace_enabled) {
+      trace_end("include");
+    }
   }
   if (in->fname != NULL) {
-    free(in->fname);
+    xfree(ALLOC_PATH, in->fname);
   }
+  xfree(ALLOC_STREAM, in->text);
+  xfree(ALLOC_STREAM, in->splices);
+  xfree(ALLOC_STREAM, in->guard);
+  xfree(ALLOC_STREAM, in->fileliteral);
   if (currentinstream == in) {
     currentinstream = in->parent;
     if (currentinstream != NULL) {
       DPRINT("Current instream is now '%s'\n", currentinstream->fname);
     }
   }
-  free(in);
+  xfree(ALLOC_STREAM, in);
+}
+
+
+
+/**
+ * @brief Reads a whole file into the text of a stream.
+ *
+ * @return 0 on success, -1 if the file cannot be read or out of memory.
+ */
+static int loadfile(instream_t *in, const char *pathname)
+{
+  FILE *file = fopen(pathname, "r");
+  if (file == NULL) {
+    perror(pathname);
+    return -1;
+  }
+  int size = 4096, len = 0;
+  char *text = xmalloc(ALLOC_STREAM, size);
+  while (text != NULL) {
+    len += fread(text + len, 1, size - len - 1, file);
+    if (len < size - 1) {
+      break;
+    }
+    char *grown = xrealloc(ALLOC_STREAM, text, 2 * size);
+    if (grown == NULL) {
+      xfree(ALLOC_STREAM, text);
+    }
+    text = grown;
+    size *= 2;
+  }
+  if (text == NULL || ferror(file)) {
+    perror(pathname);
+    xfree(ALLOC_STREAM, text);
+    fclose(file);
+    return -1;
+  }
+  fclose(file);
+  text[len] = '\0';
+  in->text = text;
+  in->len = len;
+  STATS_ADD(bytes, len);
+  return 0;
+}
+
+
+
+/**
+ * @brief Removes the line splices, backslash newline, from the text of a stream.
+ *
+ * The backslashes are found with memchr() and the text between them moved
+ * in one piece. The offsets of the splices are kept, they map the text
+ * back to the physical lines: the line of an offset is 1 plus the newlines
+ * and the splices before it.
+ *
+ * @return 0 on success, -1 if out of memory.
+ */
+static int splicelines(instream_t *in)
+{
+  char *text = in->text, *end = text + in->len, *out = text, *p = text;
+  int maxsplices = 0;
+
+  for (char *bs; (bs = memchr(p, '\\', end - p)) != NULL; ) {
+    int n = bs + 1 < end && bs[1] == '\n' ? 2 : bs + 2 < end && bs[1] == '\r' && bs[2] == '\n' ? 3 : 0;
+    if (n == 0) {  // an escape, not a splice
+      bs++;
+    }
+    if (out != p) {
+      memmove(out, p, bs - p);
+    }
+    out += bs - p;
+    p = bs + n;
+    if (n == 0) {
+      continue;
+    }
+    if (in->nsplices == maxsplices) {
+      maxsplices = maxsplices > 0 ? 2 * maxsplices : 16;
+      int *splices = xrealloc(ALLOC_STREAM, in->splices, maxsplices * sizeof(int));
+      if (splices == NULL) {
+        return -1;
+      }
+      in->splices = splices;
+    }
+    in->splices[in->nsplices++] = out - text;
+  }
+  if (out != p) {
+    memmove(out, p, end - p);
+  }
+  out += end - p;
+  *out = '\0';
+  in->len = out - text;
+  STATS_ADD(splices, in->nsplices);
+  return 0;
 }
 
 
@@ -140,15 +327,47 @@ int newinstream(const char *fname, int flag)
     fprintf(stderr, "File not found: %s\n", fname);
     return -1;
   }
+  header_t *hdr = header_get(pathname);
+  if (hdr == NULL) {
+    xfree(ALLOC_PATH, pathname);
+    return -1;
+  }
+  if (hdr->once) {
+    DPRINT("Skipping %s, #pragma once\n", pathname);
+    hdr->onceskips++;
+    xfree(ALLOC_PATH, pathname);
+    return 0;
+  }
+  if (hdr->guard != NULL && isdefinedMacro(hdr->guard, hdr->guard + strlen(hdr->guard))) {
+    DPRINT("Skipping %s, guard %s defined\n", pathname, hdr->guard);
+    hdr->guardskips++;
+    xfree(ALLOC_PATH, pathname);
+    return 0;
+  }
+  int depth = 0;  // the main file is not included
+  for (instream_t *parent = currentinstream; parent != NULL; parent = parent->parent) {
+    depth++;
+  }
+  if (bounds_check(BOUND_INCLUDE_DEPTH, depth) != 0) {
+    fprintf(stderr, "Include nested too deep: %s\n", pathname);
+    xfree(ALLOC_PATH, pathname);
+    return -1;
+  }
   DPRINT("Opening file %s\n", pathname);
-  instream_t *in = malloc(sizeof(instream_t));
+  instream_t *in = xmalloc(ALLOC_STREAM, sizeof(instream_t));
   if (in == NULL) {
+    xfree(ALLOC_PATH, pathname);
     return -1;
   }
   in->fname = pathname;
-  in->file = fopen(pathname, "r");
-  if (in->file == NULL) {
-    perror(pathname);
+  in->header = hdr;
+  in->guard = NULL;
+  in->fileliteral = NULL;
+  in->text = NULL;
+  in->splices = NULL;
+  in->nsplices = 0;
+  in->nextsplice = 0;
+  if (loadfile(in, pathname) != 0 || splicelines(in) != 0) {
     releaseinstream(in);
     return -1;
   }
@@ -164,31 +383,81 @@ int newinstream(const char *fname, int flag)
   in->buf[3] = 0;
   in->eof = 0;
   in->error = 0;
+  in->childns = 0;
+  in->sigline = 0;
+  in->guarddepth = -1;
+  in->guardline = 0;
+  in->opened = headerreport_enabled ? header_now() : 0;
+  hdr->opens++;
   in->parent = currentinstream;
   currentinstream = in;
+  STATS_INC(includes);
+  if (trace_enabled) {
+    trace_begin("include", pathname);
+  }
 
   return 0;
 }
 
 
 
+/**
+ * @brief Counts the line splices passed by moving the read position to pos.
+ */
+static inline void passsplices(instream_t *in, int pos)
+{
+  while (in->nextsplice < in->nsplices && in->splices[in->nextsplice] < pos) {
+    in->nextsplice++;
+    in->line++;
+    STATS_INC(lines);
+  }
+}
+
+
+
+/**
+ * @brief Moves the read position forward to pos, counting the lines passed.
+ */
+static void skipto(instream_t *in, int pos)
+{
+  const char *p = in->text + in->pos, *end = in->text + pos;
+  while ((p = memchr(p, '\n', end - p)) != NULL) {
+    in->line++;
+    in->col = 0;
+    STATS_INC(lines);
+    p++;
+  }
+  passsplices(in, pos);
+  in->pos = pos;
+}
+
+
+
+/**
+ * @brief Returns the next char of the text without reading it, 0 at the end.
+ */
+static inline int peekchar(instream_t *in)
+{
+  return in->pos < in->len ? (unsigned char)in->text[in->pos] : 0;
+}
+
+
+
 int rawchar(instream_t *in)
 {
   assert(in != NULL);
   if (in->eof) {
     return 0;
   }
-  int c = fgetc(in->file);
-  if (c == EOF) {
+  if (in->pos >= in->len) {
     in->eof = 1;
     return 0;
   }
-  if (c < 0) {
-    in->error = errno;
-    return c;
-  }
+  passsplices(in, in->pos + 1);
+  int c = (unsigned char)in->text[in->pos++];
   in->col++;
   if (c == '\n') {
+    STATS_INC(lines);
     in->line++;
     in->col = 0;
   }
@@ -197,6 +466,12 @@ int rawchar(instream_t *in)
 
 
 
+/**
+ * @brief returns the next char of a stream in translation phase 3
+ *
+ * Comments and runs of whitespace are returned as one space, the newline
+ * ending a line is kept. The line splices are already removed.
+ */
 int preprocessedchar(instream_t *in)
 {
   assert(in != NULL);
@@ -204,82 +479,48 @@ int preprocessedchar(instream_t *in)
     return 0;
   }
   int c = rawchar(in);
-  if (c < 0) {
-    return c;
-  }
   if (in->string) {
     if (c == '\"' && in->last != '\\') {
       in->string = 0;
     }
+    in->whitespaces = 0;
     return c;
   }
   if (c == '\"' && in->last != '\\') {
     in->string = 1;  // NOLINT
+    in->whitespaces = 0;
     return c;
   }
-  if (c == '/' && in->last != '\\') {
-    c = rawchar(in);
-    if (c == '/') {
-      while (c != '\n' && in->eof == 0) {
-        c = rawchar(in);
-        if (c < 0) {
-          return c;
-        }
-      }
-      return c;
-    }
-    if (c == '*') {
-      c = rawchar(in);
-      while (c >= 0) {
-        if (c == '*') {
-          c = rawchar(in);
-          if (c == '/') {
-            if (in->whitespaces) {
-              return preprocessedchar(in);
-            } else {
-              in->whitespaces = 1;
-              return ' ';
-            }
-          }
-        } else {
-          c = rawchar(in);
-        }
-      }
-      return c;
+  if (c == '/' && in->last != '\\' && peekchar(in) == '/') {  // line comment, up to the newline
+    const char *nl = memchr(in->text + in->pos, '\n', in->len - in->pos);
+    skipto(in, nl != NULL ? nl - in->text : in->len);
+    return preprocessedchar(in);
+  }
+  if (c == '/' && in->last != '\\' && peekchar(in) == '*') {  // block comment
+    const char *end = in->text + in->len, *p = in->pos + 2 < in->len ? in->text + in->pos + 2 : end;
+    while ((p = memchr(p, '/', end - p)) != NULL && *(p - 1) != '*') {
+      p++;
     }
-    ungetc(c, in->file);
-    c = '/';
-  }
-  if (c == '\\') {
-    c = rawchar(in);
-    if (c == '\n') {
-      if (in->whitespaces) {
-        return preprocessedchar(in);
-      }
-      in->whitespaces = 1;
-      return ' ';
+    skipto(in, p != NULL ? p + 1 - in->text : in->len);
+    if (in->whitespaces) {
+      return preprocessedchar(in);
     }
-    ungetc(c, in->file);
-    return '\\';
+    in->whitespaces = 1;
+    return ' ';
   }
   if (c == '\n') {
     in->whitespaces = 1;
     return c;
   }
-  if (isspace(c)) {
-    while (isspace(c) && in->eof == 0) {
-      if (in->whitespaces) {
-        c = rawchar(in);
-        if (c < 0) {
-          return c;
-        }
-      } else {
-        in->whitespaces = 1;
-        return ' ';
-      }
+  if (ISCHAR(c, CH_SPACE)) {
+    while (peekchar(in) != '\n' && ISCHAR(peekchar(in), CH_SPACE)) {
+      rawchar(in);
     }
-    ungetc(c, in->file);
-    return preprocessedchar(in);
+    if (in->whitespaces) {
+      return preprocessedchar(in);
+    }
+    in->whitespaces = 1;
+    return ' ';
   }
   in->whitespaces = 0;
   return c;
@@ -304,35 +545,55 @@ int readchar(instream_t *in)
 
 
 
+/**
+ * @brief reads the next logical line of the current input stream
+ *
+ * A stream that reached its end is released on the next call, so the
+ * stream of the line is still the current one while the line is processed.
+ * The empty rest behind the last newline of a file is not returned as line.
+ *
+ * @param in input stream, or NULL for the current one
+ * @param buf buffer for the line
+ * @param size size of the buffer
+ * @return 0 if a line was read, -1 if there is no more input or an error occurred
+ */
 int readline(instream_t *in, char *buf, int size)
 {
-  char *end = buf + size - 1;
+  char *end = buf + size - 1, *start = buf;
   int c;
 
   if (in == NULL) {
     in = currentinstream;
   }
+  while (in != NULL && in->eof) {
+    releaseinstream(in);
+    in = currentinstream;
+  }
   if (in == NULL) {
     return -1;
   }
 
+  STATS_ENTER(PH_LEX, phase);
   while (buf < end) {
     c = readchar(in);
     if (c < 0) {
+      STATS_LEAVE(phase);
       return c;
     }
     if (c == '\n' || c == 0) {
+      if (buf > start && *(buf - 1) == ' ' && !in->string) {  // whitespace at the end of the line
+        buf--;
+      }
       break;
     }
     *buf++ = c;
   }
   *buf = '\0';
-  if (in->eof) {
-    releaseinstream(in);
-    in = currentinstream;
-    if (in == NULL) {
-      return -1;
-    }
+  STATS_LEAVE(phase);
+  if (buf != start) {
+    in->sigline++;
+  } else if (in->eof) {  // nothing behind the last newline, not a line
+    return readline(NULL, start, size);
   }
   return 0;
 }
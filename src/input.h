@@ -17,27 +17,43 @@
 
 typedef struct instream {
   struct instream *parent;
-  FILE *file;
+  char *text;             // the file with the line splices removed, terminated
+  int len;                // length of the text
+  int *splices;           // text offsets of the removed line splices, ascending
+  int nsplices;           // number of line splices
+  int nextsplice;         // first line splice not yet passed
   char *fname;
   int line;
   int col;
-  int pos;
+  int pos;                // read position in the text
   int last;
   int whitespaces;
   int string;
   char buf[4];
   int eof;
   int error;
+  struct header *header;  // registry record of the file
+  long long opened;       // time the file was opened, for the header report
+  long long childns;      // time spent in nested includes, for the header report
+  int sigline;            // number of non-empty lines read
+  char *guard;            // include guard candidate, the macro of an #ifndef on the first line
+  int guarddepth;         // conditional depth of the guard #ifndef, -1 if the guard is invalid
+  int guardline;          // sigline of the #endif closing the guard, 0 if not yet closed
+  char *fileliteral;      // name of the file as string literal for __FILE__, made on first use
 } instream_t;
 
 
 int initsearchdirs();
 int addsearchdir(const char *dir);
+char *checkpath(const char *fname, int flag);
 
 int newinstream(const char *fname, int flag);
 void releaseinstream(instream_t *in);
+void releaseinput();
 int readline(instream_t *in, char *buf, int size);
 instream_t *getcurrentinstream();
+const char *getfileliteral(instream_t *in);
+int getlinenumber(instream_t *in);
 
 
 #endif
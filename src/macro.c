@@ -13,198 +13,298 @@
  * interact:
  *
  * addMacro(char *buf): This function is used to add a new macro to the macro
- * list. It parses the input buffer to extract the macro name, parameters (if
- * any), and replacement text. If the macro list is empty, the new Macro node
- * becomes the head of the list. Otherwise, the new Macro node is appended to
- * the end of the list.
+ * table. The table is a dense array of hot records chained per name hash,
+ * the name and the definition are stored as written in a string pool. The
+ * definition is parsed when the macro is expanded first. A macro with the
+ * name of a defined one replaces it, unless the definitions are identical.
  *
  * deleteMacro(char *name): This function is used to delete a macro from the
- * macro list. It searches the macro list for a macro with the given name and
- * removes it from the list.
+ * macro table. The last record moves into its place, the pool is compacted
+ * once half of it is unused.
  *
  * findMacro(char *start, char *end): This function is used to find a macro in
- * the macro list. It searches the macro list for a macro with the given name.
+ * the macro table. A bitmap keyed by the name rejects most identifiers before
+ * the chain of the name hash is searched.
  *
  * isdefinedMacro(char *start, char *end): This function checks if a macro is
  * defined. It uses the findMacro function to search for the macro in the macro
- * list. If the macro is found, it returns 1; otherwise, it returns 0.
+ * table. If the macro is found, it returns 1; otherwise, it returns 0.
  *
  * replaceBuf(char *start, char *buf, char *end, char *replace): This function
  * is used to replace a portion of a buffer with a given string. It replaces
  * the portion of the buffer starting at buf and ending at the end of the
  * string in the buffer with the replacement string.
  *
- * removeDoubleHash(char *buf, char *endmacro): This function is used to remove
- * double hash (##) tokens from a macro. It scans the buffer for double hash (##)
- * tokens and removes them by shifting the remaining contents of the buffer to
- * the left.
- *
- * findEndOfParameter(char *buf, char *end): This function is used to find the
- * end of a parameter in a buffer. It iterates over the buffer until it finds a
- * comma or a closing parenthesis, which signifies the end of a parameter.
+ * substitute(Macro *macro, MacroArg *args, int argc, char *out, char *outend):
+ * This function is used to build the replacement of a function-like macro from
+ * its replacement text compiled into items: text, parameters, # and ##. The
+ * arguments are spans of the invocation text, expanded once if needed.
  *
  * processMacro(char *buf, int len): This function is used to process a macro in
  * a buffer. It scans the buffer for a macro and replaces it with its replacement
- * text. If the macro is a functional macro, it also replaces the parameters in
- * the replacement text with their corresponding arguments.
+ * text. The rescanned expansion of an object-like macro is memoized in the
+ * macro and reused until a name it depends on is defined or undefined.
  *
  * processBuffer(char *buf, int len): This function is used to process a buffer
  * to recognize and replace macros. It scans the buffer for macros and replaces
- * them with their replacement text. If a macro is a functional macro, it also
- * replaces the parameters in the replacement text with their corresponding
- * arguments.
+ * them with their replacement text, which is rescanned with the macro
+ * disabled.
  *
- * The other functions in the file are helper functions that are used to skip
- * over whitespace, strings, and expressions in a buffer, check if a character
- * is a valid identifier character, and print the list of macros.
+ * The other functions in the file are helper functions that are used to
+ * compile and cache the macros, collect the arguments, expand the builtin
+ * macros, and print and profile the list of macros.
  *
  */
 #define NDEBUG
+#define DBG_SUBSYSTEM DBG_MACRO
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <stdarg.h>
+#include <time.h>
 
 #include "debug.h"
 #include "macro.h"
+#include "stats.h"
+#include "trace.h"
+#include "alloc.h"
+#include "input.h"
+#include "bounds.h"
+#include "token.h"
+
+#define PROFILE_ARGC  9
+#define MAX_NESTING   256
+#define NAMEGEN_BITS  12      // name hash buckets for the generation counters
+#define MAX_DEPS      4096    // dependencies of all expansions being recorded
+#define PREFILTER_BITS 16     // key of the macro name prefilter
+#define POOL_ERROR    ((unsigned)-1)
 
 /**
- * @struct MacroParam
- * @brief A structure to represent a parameter of a macro.
- * 
- * This structure is used to store the name of a parameter of a macro.
- * It also contains a pointer to the next parameter in the list, allowing
- * the parameters to be stored in a linked list.
+ * @brief Kinds of the items of a compiled replacement text.
+ */
+typedef enum itemkind {
+    ITEM_TEXT,             /**< Text of the replacement, unchanged. */
+    ITEM_PARAM,            /**< Parameter, replaced by the expanded argument. */
+    ITEM_RAWPARAM,         /**< Operand of ##, replaced by the argument as written. */
+    ITEM_STRINGIFY,        /**< #parameter, replaced by the argument as string literal. */
+    ITEM_PASTE,            /**< ##, the items before and after it are concatenated. */
+    ITEM_VAOPT             /**< __VA_OPT__, the next len items are dropped without variable arguments. */
+} ItemKind;
+
+
+
+/**
+ * @struct MacroItem
+ * @brief An item of a compiled replacement text.
+ */
+typedef struct macroitem {
+    unsigned char kind;    /**< ItemKind of the item. */
+    unsigned short param;  /**< Index of the parameter. */
+    unsigned offset;       /**< Start of the text in the string pool. */
+    int len;               /**< Length of the text, or number of items of __VA_OPT__. */
+} MacroItem;
+
+
+
+/**
+ * @struct MacroProfile
+ * @brief Expansion profile of all macros with the same name.
+ *
+ * Profiles are kept in their own list, so they survive an #undef of the
+ * macro. They are only created if macroprofile_enabled is set.
+ */
+typedef struct macroprofile {
+    struct macroprofile *next;      /**< Pointer to the next profile in the list. */
+    char *name;                     /**< Name of the macro. */
+    unsigned long count;            /**< Number of expansions. */
+    unsigned long outbytes;         /**< Total length of the replacements produced. */
+    unsigned long argc[PROFILE_ARGC]; /**< Expansions by argument count, the last entry counts all above. */
+    unsigned long sumdepth;         /**< Sum of the nesting depths of all expansions. */
+    int maxdepth;                   /**< Maximum nesting depth, 1 if expanded at top level. */
+    long long ns;                   /**< Time spent in processMacro(). */
+} MacroProfile;
+
+
+
+/**
+ * @struct MacroCache
+ * @brief Memoized expansion of an object-like macro.
+ *
+ * The text is the fully rescanned expansion. It stays valid as long as no
+ * name it depends on is defined or undefined. The dependencies are the name
+ * hashes of all identifiers looked up while the expansion was rescanned,
+ * macros as well as identifiers which were no macro at that time.
  */
-typedef struct macroparam {
-    struct macroparam *next; /**< Pointer to the next parameter in the list. */
-    char *name; /**< Name of the parameter. */
-} MacroParam;
+typedef struct macrocache {
+    char *text;            /**< Expansion after rescanning. */
+    unsigned long gen;     /**< Macro table generation the cache was last validated at. */
+    unsigned long long depmask; /**< Bit (hash % 64) set for every dependency. */
+    int ndeps;             /**< Number of dependencies. */
+    unsigned short deps[]; /**< Name hashes of the identifiers looked up. */
+} MacroCache;
 
 
 
 /**
  * @struct Macro
- * @brief A structure to represent a macro.
- * 
- * This structure is used to store the details of a macro, including its name,
- * parameters, and replacement text. It also contains a pointer to the next macro
- * in the list, allowing the macros to be stored in a linked list.
+ * @brief Hot record of a macro, used by the lookup and the expansion.
+ *
+ * The records are kept in a dense array, chained per bucket of the name
+ * hash. The name, the names of the parameters and the replacement text are
+ * strings in the string pool, addressed by their offsets. All other data of
+ * a macro is in the MacroCold record with the same index.
  */
 typedef struct macro {
-    struct macro *next;    /**< Pointer to the next macro in the list, or NULL if it is the last one */
-    char *name;            /**< Name of the macro, or NULL if it is a simple macro */
-    MacroParam *param;     /**< Pointer to the list of parameters of the macro, or NULL if there is no parameter */
-    char *replace;         /**< Replacement text of the macro. */
+    unsigned hash;         /**< Hash of the name. */
+    unsigned name;         /**< Offset of the name in the pool, the parameter names follow it. */
+    unsigned body;         /**< Offset of the replacement text in the pool. */
+    unsigned short namelen; /**< Length of the name. */
+    unsigned char flags;   /**< MACRO_FUNCLIKE, MACRO_VARIADIC, MACRO_RAW, MACRO_INVALID, MACRO_BUILTIN */
+    unsigned char nparams; /**< Number of parameters, the variable arguments count as one. */
+    int next;              /**< Index of the next macro in the bucket, -1 if it is the last one. */
 } Macro;
 
+#define MACRO_FUNCLIKE  1  // functional macro, invoked with (arguments)
+#define MACRO_VARIADIC  2  // the last parameter takes the variable arguments (...)
+#define MACRO_RAW       4  // not yet parsed, body is the definition behind the name
+#define MACRO_INVALID   8  // malformed definition, found by nothing but deleteMacro()
+#define MACRO_BUILTIN  16  // __FILE__, __LINE__, ..., expanded by expandBuiltin()
+
 
 
-Macro *macroList = NULL;
+/**
+ * @struct MacroCold
+ * @brief Data of a macro which is not needed for the lookup.
+ */
+typedef struct macrocold {
+    MacroItem *items;      /**< Compiled replacement text of a functional macro, or NULL */
+    char *pasted;          /**< Replacement text of a simple macro with ## pasted, or NULL */
+    int nitems;            /**< Number of items. */
+    unsigned bodyhash;     /**< Hash of the whitespace-normalized replacement text, set when parsed. */
+    MacroCache *cache;     /**< Memoized expansion of an object-like macro, or NULL */
+    MacroProfile *profile; /**< Expansion profile, or NULL if not yet expanded while profiling */
+} MacroCold;
 
 
 
 /**
- * @brief Skips over whitespace characters in a buffer.
- * 
- * This function takes a pointer to a buffer and a pointer to the end of the buffer.
- * It advances the buffer pointer past any leading whitespace characters and returns
- * the updated pointer.
- * 
- * @param buf Pointer to the start of the buffer.
- * @param end Pointer to the end of the buffer.
- * @return Pointer to the first non-whitespace character in the buffer, or the end of the buffer if no such character exists.
+ * @struct Expansion
+ * @brief Describes the last expansion done by processMacro().
  */
-char *skipSpaces(char *buf, char *end)
-{
-  assert(buf != NULL);
-  assert(end != NULL);
-  while (buf < end && isspace(*buf)) {
-    buf++;
-  }
-  return buf;
-}
+typedef struct expansion {
+    Macro *macro;          /**< The expanded macro. */
+    int used;              /**< Length of the macro invocation that was replaced. */
+    int len;               /**< Length of the replacement. */
+    int cached;            /**< 1 if the replacement is a memoized, already rescanned expansion. */
+} Expansion;
 
 
 
 /**
- * @brief Skips over a string in a buffer.
- * 
- * This function takes a pointer to a buffer and a pointer to the end of the buffer.
- * It advances the buffer pointer past a string. A string is considered to be any sequence
- * of characters enclosed in double quotes (""). If a double quote is preceded by a backslash (\"),
- * it is considered to be part of the string rather than the end of the string.
- * 
- * @param buf Pointer to the start of the buffer.
- * @param end Pointer to the end of the buffer.
- * @return Pointer to the character immediately after the end of the string, or the end of the buffer if no such character exists.
+ * @struct Region
+ * @brief An expansion the scan of processBuffer() is inside of.
+ *
+ * While the scan is inside the region, the macro is disabled, so a macro
+ * referring to itself is not expanded again. Regions of nested calls of
+ * processBuffer(), e.g. for the arguments of a function-like macro, are on
+ * the same stack, so the macros of the enclosing expansions are disabled
+ * there too.
  */
-char *skipString(char *buf, char *end)
-{
-  assert(buf != NULL);
-  assert(end != NULL);
-  do {
-    buf++;
-  } while (buf < end && !(*buf == '\"' && *(buf - 1) != '\\'));
-  return buf;
-}
+typedef struct region {
+    char *start;           /**< Start of the expansion. */
+    char *end;             /**< End of the expansion, moved when nested expansions change its length. */
+    Macro *macro;          /**< The expanded macro. */
+    unsigned short hash;   /**< Name hash of the macro. */
+    char record;           /**< 1 if the expansion of an object-like macro is recorded for memoization. */
+    int depbase;           /**< First dependency of the recording, -1 if it is not memoizable. */
+} Region;
 
 
 
-char *skipNumber(char *buf, char *end)
-{
-  assert(buf != NULL);
-  assert(end != NULL);
-  if (!isdigit(*buf)) {
-    return buf;
-  }
+/**
+ * @struct MacroArg
+ * @brief An argument of a function-like macro invocation.
+ *
+ * The argument as written is a span of the invocation text, it is not
+ * copied. Only an argument which is substituted outside of # and ## is
+ * copied to the scratch buffer to be expanded there.
+ */
+typedef struct macroarg {
+    char *raw;             /**< Start of the argument in the invocation, used as operand of # and ##. */
+    int rawlen;            /**< Length of the argument as written. */
+    char *expanded;        /**< Expanded argument in the scratch buffer, or NULL if it is not needed. */
+    int explen;            /**< Length of the expanded argument. */
+} MacroArg;
 
-  ++buf;
-  while (buf < end) {
-    char c = tolower(*buf);
-    if (c == 'u' || c == 'l') {
-      return ++buf;
-    }
-    if (!isdigit(c) && c != 'x' && c != 'a' && c != 'b' && c != 'c' && c != 'd' && c != 'e' && c != 'f') {
-      break;
-    }
-    buf++;
-  }
-  return buf;
-}
+
+
+/**
+ * @struct Scratch
+ * @brief Buffers of the function-like macro invocations at one nesting level.
+ *
+ * The buffers are kept and reused by the next invocation at the same level,
+ * they are grown only if an invocation needs more space.
+ */
+typedef struct scratch {
+    char *buf;             /**< Expanded arguments followed by the replacement being built. */
+    int size;              /**< Size of buf. */
+    MacroArg *args;        /**< Arguments of the invocation. */
+    int maxargs;           /**< Number of entries of args. */
+} Scratch;
+
+
+
+static Macro *macros = NULL;                       // hot records of all macros
+static MacroCold *colds = NULL;                    // cold records, same index
+static int nmacros = 0;
+static int maxmacros = 0;
+static int *buckets = NULL;                        // first macro per name hash bucket, -1 if empty
+static unsigned nbuckets = 0;                      // a power of two
+static char *pool = NULL;                          // names and replacement texts
+static unsigned poolsize = 0;
+static unsigned poolused = 0;
+static unsigned poolfree = 0;                      // bytes of deleted macros in the pool
+MacroProfile *profileList = NULL;
+int macroprofile_enabled = 0;
+char *unclosedinvocation = NULL;
+static Expansion lastExpansion;
+
+static unsigned long macrogen = 1;                 // incremented by every #define and #undef
+static unsigned long namegen[1 << NAMEGEN_BITS];  // generation of the last change per name hash
+static unsigned short deps[MAX_DEPS];              // dependencies of the expansions being recorded
+static int ndeps = 0;
+static int recording = 0;                          // number of expansions being recorded
+static Region regions[MAX_NESTING];                // expansions the scans are inside of
+static int nregions = 0;
+static int scanbase = 0;                           // first region of the innermost scan
+static unsigned long long prefilter[(1 << PREFILTER_BITS) / 64];  // set if a macro name has the key
+static unsigned char prefiltercount[1 << PREFILTER_BITS];        // macros per key, sticks at 255
+static Scratch scratch[MAX_NESTING];               // buffers of the function-like invocations per nesting level
+static int scratchlevel = 0;
+static unsigned long counter = 0;                  // next value of __COUNTER__
+static long expansiongrowth = 0;                   // growth of the current top-level expansion over its invocation
+static char builtindate[16];                       // "Mmm dd yyyy" of __DATE__, set on first use
+static char builtintime[16];                       // "hh:mm:ss" of __TIME__, set on first use
 
 
 
 /**
- * @brief Skips over an expression in a buffer.
+ * @brief Skips over whitespace characters in a buffer.
  * 
  * This function takes a pointer to a buffer and a pointer to the end of the buffer.
- * It advances the buffer pointer past an expression. An expression is considered to be
- * any sequence of characters enclosed in parentheses (()). Nested expressions are handled
- * correctly. If an expression contains a string (a sequence of characters enclosed in double
- * quotes ("")), the string is skipped over using the skipString function.
+ * It advances the buffer pointer past any leading whitespace characters and returns
+ * the updated pointer.
  * 
  * @param buf Pointer to the start of the buffer.
  * @param end Pointer to the end of the buffer.
- * @return Pointer to the character immediately after the end of the expression, or the end of the buffer if no such character exists.
+ * @return Pointer to the first non-whitespace character in the buffer, or the end of the buffer if no such character exists.
  */
-char *skipExpression(char *buf, char *end)
+char *skipSpaces(char *buf, char *end)
 {
   assert(buf != NULL);
   assert(end != NULL);
-  int count = 1;
-  while (buf < end && count > 0) {
-    switch (*++buf) {
-      case '(':
-        count++;
-        break;
-      case ')':
-        count--;
-        break;
-      case '\"':
-        buf = skipString(buf, end);
-        break;
-    }
+  while (buf < end && ISCHAR(*buf, CH_SPACE)) {
+    buf++;
   }
   return buf;
 }
@@ -212,38 +312,48 @@ char *skipExpression(char *buf, char *end)
 
 
 /**
- * @brief Prints the list of macros.
+ * @brief Returns the name of the first parameter, the others follow it in the pool.
+ */
+static inline char *firstParam(Macro *macro)
+{
+  return pool + macro->name + macro->namelen + 1;
+}
+
+
+
+/**
+ * @brief Logs the list of macros at debug level.
  *
- * This function prints the list of macros stored in the `macroList` data structure.
- * It iterates through each macro in the list and prints its name, parameters (if any),
- * and replacement text (if any).
+ * This function logs the macros stored in the macro table, one message per
+ * macro with its name, parameters (if any) and replacement text. Macros not
+ * parsed yet are logged as they were defined.
  */
 void printMacroList()
 {
-  Macro *temp = macroList;
+  char line[256];
   // cppcheck-suppress syntaxError
   DPRINT("*** Macro List:\n");
-  while (temp != NULL) {
-    DPRINT("%s", temp->name);
-    MacroParam *param = temp->param;
-    if (param != NULL)
-      DPRINT("(");
-    while (param != NULL) {
-      if (param->name != NULL)
-        DPRINT("%s", param->name);
-      param = param->next;
-      if (param != NULL) {
-        DPRINT(", ");
-      } else {
-        DPRINT(")");
-      }
+  for (Macro *macro = macros; macro < macros + nmacros; macro++) {
+    if (macro->flags & (MACRO_INVALID | MACRO_BUILTIN)) {
+      continue;
     }
-    if (temp->replace != NULL) {
-      DPRINT(" -> %s\n", temp->replace);
-    } else {
-      DPRINT("\n");
+    if (macro->flags & MACRO_RAW) {  // not parsed, as written
+      DPRINT("%s%s%s\n", pool + macro->name, (macro->flags & MACRO_FUNCLIKE) ? "" : " -> ", pool + macro->body);
+      continue;
+    }
+    int len = snprintf(line, sizeof(line), "%s", pool + macro->name);
+    if (macro->flags & MACRO_FUNCLIKE) {
+      char *param = firstParam(macro);
+      len += snprintf(line + len, sizeof(line) - len, "(");
+      for (int i = 0; i < macro->nparams && len < (int)sizeof(line); i++, param += strlen(param) + 1) {
+        int variadic = i == macro->nparams - 1 && (macro->flags & MACRO_VARIADIC);
+        len += snprintf(line + len, sizeof(line) - len, "%s%s%s", i > 0 ? ", " : "", param, variadic ? "..." : "");
+      }
+      if (len < (int)sizeof(line)) {
+        snprintf(line + len, sizeof(line) - len, ")");
+      }
     }
-    temp = temp->next;
+    DPRINT("%s -> %s\n", line, pool + macro->body);
   }
   DPRINT("*** EOL\n");
 }
@@ -251,386 +361,1762 @@ void printMacroList()
 
 
 /**
- * @brief Checks if a character is a valid identifier character.
+ * @brief Returns the next char of a text with whitespace normalized.
  *
- * This function checks whether the given character is a valid identifier character.
- * An identifier character can be an alphabet (uppercase or lowercase), a digit, or an underscore.
+ * A run of whitespace outside of literals is returned as one space, at the
+ * end of the text it is dropped.
  *
- * @param c The character to be checked.
- * @param idx The index of the character in the string.
- * @return Returns 1 if the character is a valid identifier character, 0 otherwise.
+ * @param text The text, advanced behind the char.
+ * @param state Quote char of the literal the text is in or 0, bit 8 if the char is escaped.
+ * @return The char, 0 at the end of the text.
  */
-int isIdent(char c, int idx)
+static int normalChar(const char **text, int *state)
 {
-  if (idx < 0 || c == '\0') {
+  const char *p = *text;
+  int c = (unsigned char)*p;
+
+  if (c == '\0') {
     return 0;
   }
-
-  return idx > 0 ? (isalnum(c) || c == '_') : (isalpha(c) || c == '_');
+  if (*state == 0 && ISCHAR(c, CH_SPACE)) {
+    while (ISCHAR(*p, CH_SPACE)) {
+      p++;
+    }
+    *text = p;
+    return *p == '\0' ? 0 : ' ';
+  }
+  if (*state & 0x100) {  // escaped
+    *state &= 0xff;
+  } else if (*state == 0) {
+    if (c == '\"' || c == '\'') {
+      *state = c;
+    }
+  } else if (c == '\\') {
+    *state |= 0x100;
+  } else if (c == *state) {
+    *state = 0;
+  }
+  *text = p + 1;
+  return c;
 }
 
 
 
 /**
- * @brief Parses the input buffer to extract the macro name, parameters (if any), and replacement text.
- *
- * This function parses the input buffer to extract the macro name, parameters (if any), and replacement text.
- * It starts by finding the beginning of the macro name and then searches for the end of the macro name,
- * which must be a valid identifier followed by a '(' or a space. If the macro name is not valid or if there
- * is no '(' or space after it, the function returns -1 to indicate an error.
- *
- * If a '(' is found after the macro name, the function proceeds to parse the parameter list. It iterates through
- * the buffer, extracting each parameter name and adding it to the parameter list. The parameter names must be valid
- * identifiers separated by commas. If a ')' is found, the parameter list is complete. If a ',' is found, the function
- * continues parsing for the next parameter name. If any error occurs during the parsing of the parameter list,
- * the function returns -1 to indicate an error.
- * If the parameter list is empty, the function creates a single MacroParam node with a NULL name to represent
- * a functional macro without parameters. In case no '(' is found after the macro name, the function creates no
- * MacroParam node to represent a simple macro without parameters, param is NULL.
- *
- * After parsing the parameter list, the function removes any preceding spaces and extracts the replacement text.
- * The replacement text is the remaining part of the buffer after the parameter list. If the replacement text is not
- * empty, it is stored in the newly created Macro node. If the buffer is too small to store the replacement text,
- * the function returns -1 to indicate an error.
- *
- * Finally, the function creates a new Macro node, initializes its fields with the parsed information, and adds it
- * to the macro list. If the macro list is empty, the new Macro node becomes the head of the list. Otherwise, the
- * new Macro node is appended to the end of the list.
- *
- * @param buf The input buffer containing the macro definition.
- * @return 0 if the macro was successfully added, -1 if there was an error.
- *
- * @startuml
- * 
- * start
- * :Find beginning of macro name;
- * :Search for end of macro name;
- * if (Macro name is not valid or no '(' or space after it) then
- *   :Return -1;
- * endif
- * if (A '(' is found after the macro name) then
- *   :Parse parameter list;
- *   if (Error occurs during parsing) then
- *     :Return -1;
- *   endif
- * endif
- * :Remove preceding spaces;
- * :Extract replacement text;
- * if (Buffer is too small to store replacement text) then
- *   :Return -1;
- * endif
- * :Create new Macro node;
- * :Initialize fields with parsed information;
- * if (Macro list is empty) then
- *   :New Macro node becomes head of list;
- * else
- *   :Append new Macro node to end of list;
- * endif
- * :Return 0;
- *
- * @enduml
+ * @brief Hash of a text with whitespace normalized, see normalChar().
  */
-int addMacro(char *buf)
+static unsigned normalHash(const char *text)
 {
-  char *token, *end = buf + strlen(buf), *name = NULL;
-
-  // find begin of macro name
-  while (buf < end && isspace(*buf)) {
-    buf++;
+  unsigned h = 2166136261u;
+  int state = 0, c;
+  while ((c = normalChar(&text, &state)) != 0) {
+    h = (h ^ c) * 16777619u;
   }
+  return h;
+}
 
-  // find end of macro name, has to be a valid identifier and there has to be a '(' or ' ' after it
-  name = buf;
-  int i = 0;
-  while (buf < end && isIdent(*buf, i++)) {
-    buf++;
-  }
-  char type = *buf;
-  *buf = '\0';
-  if (*name == '\0' || strchr(" (", type) == NULL) {
-    return -1;    /** @todo  error no macro */
-  }
 
-  // check for parameter list if a '(' is found
-  MacroParam *paramList = NULL;
-  if (type == '(') {
-    buf++;
-    MacroParam *param = NULL;
-    while (buf < end) {
-      if (param == NULL) {
-        param = malloc(sizeof(MacroParam));
-        paramList = param;
-      } else {
-        param->next = malloc(sizeof(MacroParam));
-        param = param->next;
-      }
-      param->next = NULL;
-      param->name = NULL;
-      // remove preciding spaces
-      while (buf < end && isspace(*buf)) {
-        buf++;
-      }
-      // find end of parameter name, has to be a valid identifier
-      i = 0;
-      token = buf;
-      while (buf < end && isIdent(*buf, i++)) {
-        buf++;
-      }
-      if (buf >= end) {
-        return -1;    /** @todo error no ')' */
-      }
-      char c = *buf;
-      *buf++ = '\0';
-      if (isspace(c)) {
-        // remove trailing spaces
-        while (buf < end && isspace(*buf)) {
-          buf++;
-        }
-        if (buf >= end) {
-          return -1;    /** @todo error no ')' */
-        }
-        c = *buf;
-        buf++;
-      }
-      if (*token != '\0')
-        param->name = strdup(token);
-      if (c == ')') {
-        break;
-      }
-      if (c != ',') {
-        return -1;    /** @todo  error no ',' */
-      }
-    }
-  } else {
-    if (buf < end) {
-      buf++;
-    }
-  }
-  // remove preciding spaces before the replacement text
-  buf = skipSpaces(buf, end);
 
-  // Create a new Macro node
-  Macro *newMacro = malloc(sizeof(Macro));
-  newMacro->next = NULL;
-  newMacro->name = strdup(name);
-  newMacro->param = paramList;
-  if (*buf != '\0') {
-    newMacro->replace = strdup(buf);
-  } else {
-    newMacro->replace = NULL;
+static unsigned fullHash(const char *name, int len)
+{
+  unsigned h = 2166136261u;
+  for (int i = 0; i < len; i++) {
+    h = (h ^ (unsigned char)name[i]) * 16777619u;
   }
+  return h;
+}
 
-  // Add the new macro to the macro list
-  if (macroList == NULL) {
-    macroList = newMacro;
-  } else {
-    Macro *temp = macroList;
-    while (temp->next != NULL) {
-      temp = temp->next;
-    }
-    temp->next = newMacro;
-  }
 
-  return 0;
+
+static inline unsigned short foldHash(unsigned h)
+{
+  return (h ^ (h >> 16)) & ((1 << NAMEGEN_BITS) - 1);
+}
+
+
+
+static unsigned short nameHash(const char *name, int len)
+{
+  return foldHash(fullHash(name, len));
 }
 
 
 
 /**
- * @brief Deletes a macro from the macro list.
- * 
- * This function takes the name of a macro and deletes it from the macro list.
- * It frees all memory associated with the macro, including the memory for the
- * macro's name, replacement text, and parameters. If the macro is not found in
- * the list, it returns -1.
- * 
- * @param name Name of the macro to delete.
- * @return 0 if the macro was successfully deleted, -1 if the macro was not found.
- * 
- * @startuml
- * start
- * :Initialize temp to macroList;
- * :Initialize prev to NULL;
- * while (temp is not NULL)
- *   :Compare temp->name with name;
- *   if (temp->name equals name) then (yes)
- *     :Remove temp from list;
- *     :Free temp->name;
- *     :Free temp->replace;
- *     while (param is not NULL)
- *       :Free param->name;
- *       :Move to next param;
- *     endwhile
- *     :Free temp;
- *     :Return 0;
- *     stop
- *   else (no)
- *     :Move to next macro;
- *   endif
- * endwhile
- * :Return -1;
- * stop
- * @enduml
+ * @brief Records a #define or #undef of a macro, memoized expansions depending on it become invalid.
  */
-int deleteMacro(char *name)
+static void touchName(Macro *macro)
 {
-  Macro *temp = macroList, *prev = NULL;
-
-  while (temp != NULL) {
-    if (strcmp(temp->name, name) == 0) {
-      if (prev == NULL) {
-        macroList = temp->next;
-      } else {
-        prev->next = temp->next;
-      }
-      free(temp->name);
-      free(temp->replace);
-      MacroParam *param = temp->param;
-      while (param != NULL) {
-        if (param->name != NULL)
-          free(param->name);
-        MacroParam *next = param->next;
-        free(param);
-        param = next;
-      }
-      free(temp);
-      return 0;
-    }
-    prev = temp;
-    temp = temp->next;
-  }
-  return -1;
+  namegen[foldHash(macro->hash)] = ++macrogen;
 }
 
 
 
 /**
- * @brief Finds a macro in the macro list.
- *
- * This function searches the macro list for a macro with the given name.
+ * @brief Key of a name in the prefilter: first char, last char and length.
  *
- * @param start The start of the name.
- * @param end The end of the name.
- * @return A pointer to the Macro node if the macro is found, NULL otherwise.
+ * A bitmap of the keys rejects most identifiers which are no macro before
+ * the table is searched. Every #define and #undef updates a counter per key,
+ * so the bitmap stays exact for keys used by less than 255 macros.
  */
-Macro *findMacro(char *start, char *end)
+static inline unsigned prefilterKey(const char *name, int len)
 {
-  Macro *temp = macroList;
+  return ((unsigned char)name[0] & 0x7f) << 9 | ((unsigned char)name[len - 1] & 0x3f) << 3 | (len & 7);
+}
 
-  // DPRINT("findMacro: %.*s\n", (int)(end - start), start);
-  while (temp != NULL) {
-    // DPRINT("findMacro: check %s\n", temp->name);
-    if (strlen(temp->name) == (size_t)(end - start) && strncmp(temp->name, start, strlen(temp->name)) == 0) {
-      return temp;
-    }
-    temp = temp->next;
+
+
+static void prefilterAdd(const char *name)
+{
+  unsigned key = prefilterKey(name, strlen(name));
+  if (prefiltercount[key] < 255) {
+    prefiltercount[key]++;
   }
-  return NULL;
+  prefilter[key / 64] |= 1ULL << (key % 64);
 }
 
 
 
-/**
- * @brief Checks if a macro is defined.
- * 
- * This function takes a pointer to the start and end of a macro name in a buffer.
- * It uses the findMacro function to search for the macro in the macro list.
- * If the macro is found, it returns 1; otherwise, it returns 0.
- * 
- * @param start Pointer to the start of the macro name in the buffer.
- * @param end Pointer to the end of the macro name in the buffer.
- * @return 1 if the macro is defined, 0 otherwise.
- */
-int isdefinedMacro(char *start, char *end)
+static void prefilterRemove(const char *name)
 {
-  return findMacro(start, end) != NULL;
+  unsigned key = prefilterKey(name, strlen(name));
+  if (prefiltercount[key] < 255 && --prefiltercount[key] == 0) {
+    prefilter[key / 64] &= ~(1ULL << (key % 64));
+  }
 }
 
 
 
 /**
- * @brief Replaces a portion of a buffer with a given string.
- * 
- * This function takes pointers to the start and end of a buffer, a pointer to the portion
- * of the buffer to be replaced, and a replacement string. It replaces the portion of the
- * buffer starting at `buf` and ending at the end of the string in the buffer with the
- * replacement string. If the buffer is too small to hold the replacement string and the
- * remaining contents of the buffer, it returns NULL.
- * 
- * @param start Pointer to the start of the buffer.
- * @param buf Pointer to the portion of the buffer to be replaced.
- * @param end Pointer to the end of the buffer.
- * @param replace The replacement string.
- * @return Pointer to the character immediately after the replacement string in the buffer, or NULL if the buffer is too small.
+ * @brief Adds a looked up identifier to the dependencies of the expansions being recorded.
  */
-char *replaceBuf(char *start, char *buf, char *end, char *replace)
+static void addDependency(unsigned short hash)
 {
-  char * endstr = buf + strlen(buf) + 1;
-  if (replace == NULL) {
-    replace = "";
-  }
-  int rlen = strlen(replace);
-
-  if (start + rlen + (endstr - buf) >= end) {  // buffer too small
-    return NULL;
+  if (ndeps < MAX_DEPS) {
+    deps[ndeps] = hash;
   }
-
-  memmove(start + rlen, buf, endstr - buf);
-  memcpy(start, replace, rlen);
-
-  return start + rlen;
+  ndeps++;  // an overflow is detected by the recording, which is then dropped
 }
 
 
 
 /**
- * @brief Removes double hash (##) tokens from a macro.
- * 
- * This function takes a pointer to a buffer and a pointer to the end of the macro in the buffer.
- * It scans the buffer for double hash (##) tokens and removes them by shifting the remaining
- * contents of the buffer to the left. The end of the string in the buffer is updated accordingly.
- * 
- * @param buf Pointer to the start of the buffer.
- * @param endmacro Pointer to the end of the macro in the buffer.
+ * @brief Checks if a memoized expansion is still valid, invalid caches are released.
+ *
+ * Every #define and #undef increments a generation counter and stores it for
+ * the hash of the name. The expansion is valid as long as none of its
+ * dependencies changed after it was validated last.
  */
-void removeDoubleHash(char *buf, char *endmacro)
+static int validCache(Macro *macro)
 {
-  char *endstr = endmacro + strlen(endmacro);
-
-  while (buf < endmacro) {
-    if (*buf == '#' && *(buf + 1) == '#') {
-      // remove both '#'
-      memmove(buf, buf + 2, endstr - buf - 2);
-      endstr -= 2;
-      endmacro -= 2;
-    } else {
-      buf++;
+  MacroCold *cold = &colds[macro - macros];
+  MacroCache *cache = cold->cache;
+  if (cache->gen == macrogen) {
+    return 1;
+  }
+  for (int i = 0; i < cache->ndeps; i++) {
+    if (namegen[cache->deps[i]] > cache->gen) {
+      xfree(ALLOC_MACRO, cache->text);
+      xfree(ALLOC_MACRO, cache);
+      cold->cache = NULL;
+      return 0;
     }
   }
+  cache->gen = macrogen;
+  return 1;
 }
 
 
 
 /**
- * @brief Finds the end of a parameter in a buffer.
- * 
- * This function iterates over the buffer until it finds a comma or a closing parenthesis,
- * which signifies the end of a parameter. It also handles nested functional macros,
- * other expressions, and strings.
- * 
- * @param buf Pointer to the start of the parameter.
- * @param end Pointer to the end of the buffer.
- * @return Pointer to the end of the parameter.
- */
-char *findEndOfParameter(char *buf, char *end) {
-  while (buf < end && *buf != ',' && *buf != ')') {  // find end of parameter
-    if (*buf == '\"')  // skip string
-      buf = skipString(buf, end);
-    if (*buf == '(')  // nested functional macro or other expressions or strings
-      buf = skipExpression(buf, end);
-    buf++;
+ * @brief Checks if a memoized expansion can be used inside the current regions.
+ *
+ * The memoized expansion was rescanned with all macros enabled, it differs if a
+ * macro it expanded is disabled now.
+ */
+static int usableCache(MacroCache *cache)
+{
+  for (int i = 0; i < nregions; i++) {
+    if (cache->depmask & (1ULL << (regions[i].hash % 64))) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+
+
+/**
+ * @brief Memoizes the rescanned expansion of an object-like macro.
+ *
+ * @param macro The expanded macro.
+ * @param text Start of the expansion.
+ * @param len Length of the expansion.
+ * @param depbase Index of the first dependency recorded during the expansion.
+ */
+static void storeCache(Macro *macro, const char *text, int len, int depbase)
+{
+  int n = ndeps - depbase;
+  MacroCache *cache = xmalloc(ALLOC_MACRO, sizeof(MacroCache) + n * sizeof(unsigned short));
+  if (cache == NULL) {
+    return;
+  }
+  cache->text = xmalloc(ALLOC_MACRO, len + 1);
+  if (cache->text == NULL) {
+    xfree(ALLOC_MACRO, cache);
+    return;
+  }
+  memcpy(cache->text, text, len);
+  cache->text[len] = '\0';
+  cache->gen = macrogen;
+  cache->ndeps = n;
+  cache->depmask = 0;
+  for (int i = 0; i < n; i++) {
+    cache->deps[i] = deps[depbase + i];
+    cache->depmask |= 1ULL << (cache->deps[i] % 64);
+  }
+  colds[macro - macros].cache = cache;
+}
+
+
+
+/**
+ * @brief Checks if a character is a valid identifier character.
+ *
+ * This function checks whether the given character is a valid identifier character.
+ * An identifier character can be an alphabet (uppercase or lowercase), a digit, or an underscore.
+ *
+ * @param c The character to be checked.
+ * @param idx The index of the character in the string.
+ * @return Returns 1 if the character is a valid identifier character, 0 otherwise.
+ */
+int isIdent(char c, int idx)
+{
+  if (idx < 0 || c == '\0') {
+    return 0;
+  }
+
+  return ISCHAR(c, idx > 0 ? CH_IDCONT : CH_IDSTART) != 0;
+}
+
+
+
+/**
+ * @brief Appends a string to the string pool.
+ *
+ * @param str The string, does not need to be terminated.
+ * @param len Length of the string.
+ * @return Offset of the terminated string in the pool, or POOL_ERROR if out of memory.
+ */
+static unsigned poolAdd(const char *str, int len)
+{
+  if (poolused + len + 1 > poolsize) {
+    unsigned size = poolsize > 0 ? poolsize : 1024;
+    while (poolused + len + 1 > size) {
+      size += size / 2;
+    }
+    char *newpool = xrealloc(ALLOC_MACRO, pool, size);
+    if (newpool == NULL) {
+      return POOL_ERROR;
+    }
+    pool = newpool;
+    poolsize = size;
+  }
+  unsigned offset = poolused;
+  memcpy(pool + offset, str, len);
+  pool[offset + len] = '\0';
+  poolused += len + 1;
+  return offset;
+}
+
+
+
+/**
+ * @brief Returns the length of the name and the parameter names in the pool.
+ */
+static unsigned nameBlockLen(Macro *macro)
+{
+  char *param = firstParam(macro);
+  for (int i = 0; i < macro->nparams; i++) {
+    param += strlen(param) + 1;
+  }
+  return param - (pool + macro->name);
+}
+
+
+
+/**
+ * @brief Copies the strings of all macros to a new pool, dropping those of deleted macros.
+ */
+static void compactPool()
+{
+  char *newpool = xmalloc(ALLOC_MACRO, poolused - poolfree + 4096);
+  if (newpool == NULL) {
+    return;  // keep the old pool
+  }
+  unsigned used = 0;
+  for (int i = 0; i < nmacros; i++) {
+    Macro *macro = &macros[i];
+    unsigned len = nameBlockLen(macro);
+    memcpy(newpool + used, pool + macro->name, len);
+    macro->name = used;
+    used += len;
+    len = strlen(pool + macro->body) + 1;
+    memcpy(newpool + used, pool + macro->body, len);
+    for (int j = 0; j < colds[i].nitems; j++) {  // text items address the pool
+      colds[i].items[j].offset += used - macro->body;
+    }
+    macro->body = used;
+    used += len;
+  }
+  xfree(ALLOC_MACRO, pool);
+  pool = newpool;
+  poolsize = poolused - poolfree + 4096;
+  poolused = used;
+  poolfree = 0;
+}
+
+
+
+/**
+ * @brief Inserts a macro at the head of the chain of its bucket, a name is in the table only once.
+ */
+static void linkMacro(int idx)
+{
+  int *head = &buckets[macros[idx].hash & (nbuckets - 1)];
+  macros[idx].next = *head;
+  *head = idx;
+}
+
+
+
+/**
+ * @brief Returns the link pointing to the macro, in its bucket or its predecessor.
+ */
+static int *findLink(int idx)
+{
+  int *next = &buckets[macros[idx].hash & (nbuckets - 1)];
+  while (*next != idx) {
+    next = &macros[*next].next;
+  }
+  return next;
+}
+
+
+
+/**
+ * @brief Makes room for one more macro, the records grow by half and the buckets are doubled when they are all used.
+ *
+ * @return 0 on success, -1 if out of memory.
+ */
+static int growTable()
+{
+  if (nmacros == maxmacros) {
+    int n = maxmacros > 0 ? maxmacros + maxmacros / 2 : 64;
+    Macro *newmacros = xrealloc(ALLOC_MACRO, macros, n * sizeof(Macro));
+    if (newmacros == NULL) {
+      return -1;
+    }
+    macros = newmacros;
+    MacroCold *newcolds = xrealloc(ALLOC_MACRO, colds, n * sizeof(MacroCold));
+    if (newcolds == NULL) {
+      return -1;
+    }
+    colds = newcolds;
+    memset(colds + maxmacros, 0, (n - maxmacros) * sizeof(MacroCold));
+    maxmacros = n;
+  }
+  if ((unsigned)nmacros >= nbuckets) {
+    unsigned n = nbuckets > 0 ? 2 * nbuckets : 64;
+    int *oldbuckets = buckets;
+    unsigned oldn = nbuckets;
+    buckets = xmalloc(ALLOC_MACRO, n * sizeof(int));
+    if (buckets == NULL) {
+      buckets = oldbuckets;
+      return -1;
+    }
+    nbuckets = n;
+    memset(buckets, -1, n * sizeof(int));
+    for (unsigned b = 0; b < oldn; b++) {
+      for (int idx = oldbuckets[b], next; idx >= 0; idx = next) {
+        next = macros[idx].next;
+        linkMacro(idx);
+      }
+    }
+    xfree(ALLOC_MACRO, oldbuckets);
+  }
+  return 0;
+}
+
+
+
+static char *append(char *out, char *outend, const char *text, int len)
+{
+  if (out == NULL || len >= outend - out) {
+    return NULL;
+  }
+  memcpy(out, text, len);
+  return out + len;
+}
+
+
+
+/**
+ * @brief Writes an argument as string literal.
+ *
+ * Whitespace between tokens becomes a single space, '"' and '\' in string
+ * and character literals are escaped.
+ *
+ * @return Pointer behind the string literal, or NULL if it does not fit.
+ */
+static char *stringify(char *out, char *outend, const char *raw, int rawlen)
+{
+  char *end = (char *)raw + rawlen;
+  pptoken_t tok;
+
+  if (out == NULL || outend - out < 2) {
+    return NULL;
+  }
+  *out++ = '\"';
+  for (char *p = lexfirst((char *)raw, end, &tok); tok.kind != TK_END; p = lextoken(p, end, &tok)) {
+    int literal = tok.kind == TK_STRING || tok.kind == TK_CHAR;
+    if (outend - out < 2 * tok.len + 2) {
+      return NULL;
+    }
+    if ((tok.flags & TF_SPACE) && !(tok.flags & TF_BOL)) {
+      *out++ = ' ';
+    }
+    for (int i = 0; i < tok.len; i++) {
+      if (literal && (tok.start[i] == '\"' || tok.start[i] == '\\')) {
+        *out++ = '\\';
+      }
+      *out++ = tok.start[i];
+    }
+  }
+  *out++ = '\"';
+  return out;
+}
+
+
+
+/**
+ * @brief Marks the arguments which are substituted outside of # and ## as to be expanded.
+ *
+ * The variable arguments are expanded for __VA_OPT__ and a comma pasted with
+ * them too, both depend on whether they are empty after expansion.
+ */
+static void markExpanded(Macro *macro, MacroArg *args)
+{
+  MacroCold *cold = &colds[macro - macros];
+
+  for (int i = 0; i < cold->nitems; i++) {
+    MacroItem *item = &cold->items[i];
+    if (item->kind == ITEM_PARAM) {
+      args[item->param].expanded = args[item->param].raw;  // expanded by expandArgs()
+    } else if (item->kind == ITEM_VAOPT
+               || (item->kind == ITEM_RAWPARAM && item->param == macro->nparams - 1 && i > 0
+                   && cold->items[i - 1].kind == ITEM_PASTE && (macro->flags & MACRO_VARIADIC))) {
+      args[macro->nparams - 1].expanded = args[macro->nparams - 1].raw;
+    }
+  }
+}
+
+
+
+/**
+ * @brief Checks if the variable arguments have no tokens after expansion.
+ */
+static int emptyVaargs(MacroArg *vaargs)
+{
+  pptoken_t tok;
+  const char *text = vaargs->expanded != NULL ? vaargs->expanded : vaargs->raw;
+  int len = vaargs->expanded != NULL ? vaargs->explen : vaargs->rawlen;
+
+  lextoken((char *)text, (char *)text + len, &tok);
+  return tok.kind == TK_END;
+}
+
+
+
+/**
+ * @brief Checks if a token and the text following it would be read as one token.
+ *
+ * The rules of a punctuator only look at its last char, e.g. "--" followed by
+ * '-' counts as merging, which costs a space at worst.
+ *
+ * @param from Start of the text, bounds the search for the start of the token.
+ * @param last Last char of the token.
+ * @param next First char of the following text.
+ * @return 1 if a space has to separate them, 0 otherwise.
+ */
+static int tokensMerge(const char *from, const char *last, char next)
+{
+  char c = *last;
+
+  if (ISCHAR(c, CH_IDCONT) || c == '.') {
+    const char *first = last;
+    while (first > from && (ISCHAR(first[-1], CH_IDCONT) || first[-1] == '.')) {
+      first--;
+    }
+    if (ISCHAR(*first, CH_DIGIT) || (*first == '.' && ISCHAR(first[1], CH_DIGIT))) {  // number
+      return ISCHAR(next, CH_IDCONT) || next == '.'
+          || ((next == '+' || next == '-') && (c == 'e' || c == 'E' || c == 'p' || c == 'P'));
+    }
+    if (c != '.') {  // identifier, L"x" is a wide string
+      return ISCHAR(next, CH_IDCONT) || next == '\"' || next == '\'';
+    }
+  }
+  switch (c) {
+    case '.': return next == '.' || ISCHAR(next, CH_DIGIT);
+    case '+': return next == '+' || next == '=';
+    case '-': return next == '-' || next == '=' || next == '>';
+    case '<': return next == '<' || next == '=' || next == '%' || next == ':';
+    case '>': return next == '>' || next == '=';
+    case '&': return next == '&' || next == '=';
+    case '|': return next == '|' || next == '=';
+    case '/': return next == '/' || next == '*' || next == '=';  // comments too
+    case '%': return next == '%' || next == ':' || next == '>' || next == '=';
+    case ':': return next == ':' || next == '>';
+    case '#': return next == '#' || next == '%';
+    case '*': case '=': case '!': case '^': return next == '=';
+    default: return 0;
+  }
+}
+
+
+
+/**
+ * @brief Appends a space if the text before `out` and `next` would be read as one token.
+ */
+static char *separate(char *outstart, char *out, char *outend, char next)
+{
+  if (out == NULL || out == outstart || !tokensMerge(outstart, out - 1, next)) {
+    return out;
+  }
+  return append(out, outend, " ", 1);
+}
+
+
+
+/**
+ * @brief Builds the replacement of a function-like macro invocation from its items.
+ *
+ * A comma followed by ## and variable arguments which are empty after
+ * expansion is removed (GNU extension), __VA_OPT__ is dropped with them. A space separates an expanded argument from the text around it
+ * where they would merge, e.g. -x with x = -1 gives "- -1".
+ *
+ * @return Pointer behind the replacement, or NULL if it does not fit.
+ */
+static char *substitute(Macro *macro, MacroArg *args, int argc, char *out, char *outend)
+{
+  char *const outstart = out;
+  MacroArg *vaargs = macro->flags & MACRO_VARIADIC ? &args[argc - 1] : NULL;
+  MacroCold *cold = &colds[macro - macros];
+
+  for (int i = 0; i < cold->nitems && out != NULL; i++) {
+    MacroItem *item = &cold->items[i];
+    MacroArg *arg = item->kind != ITEM_TEXT && item->kind != ITEM_PASTE && item->kind != ITEM_VAOPT ? &args[item->param] : NULL;
+    switch (item->kind) {
+      case ITEM_TEXT:
+        if (i > 0 && cold->items[i - 1].kind == ITEM_PARAM && item->len > 0) {
+          out = separate(outstart, out, outend, pool[item->offset]);
+        }
+        out = append(out, outend, pool + item->offset, item->len);
+        break;
+      case ITEM_PARAM:
+        if (arg->explen > 0) {
+          out = separate(outstart, out, outend, *arg->expanded);
+        }
+        out = append(out, outend, arg->expanded, arg->explen);
+        break;
+      case ITEM_RAWPARAM:
+        if (arg == vaargs && i > 0 && cold->items[i - 1].kind == ITEM_PASTE && out > outstart && *(out - 1) == ','
+            && emptyVaargs(vaargs)) {
+          out--;  // the arguments expand to nothing
+          break;
+        }
+        out = append(out, outend, arg->raw, arg->rawlen);
+        break;
+      case ITEM_STRINGIFY:
+        out = stringify(out, outend, arg->raw, arg->rawlen);
+        break;
+      case ITEM_VAOPT:
+        if (emptyVaargs(vaargs)) {
+          i += item->len;
+        }
+        break;
+      default:  // ITEM_PASTE, the operands are already adjacent
+        break;
+    }
+  }
+  return out;
+}
+
+
+
+static int addItem(MacroCold *cold, int *maxitems, int kind, int param, unsigned offset, int len)
+{
+  if (cold->nitems == *maxitems) {
+    int n = *maxitems > 0 ? 2 * *maxitems : 8;
+    MacroItem *items = xrealloc(ALLOC_MACRO, cold->items, n * sizeof(MacroItem));
+    if (items == NULL) {
+      return -1;
+    }
+    cold->items = items;
+    *maxitems = n;
+  }
+  MacroItem *item = &cold->items[cold->nitems++];
+  item->kind = kind;
+  item->param = param;
+  item->offset = offset;
+  item->len = len;
+  return 0;
+}
+
+
+
+static int addText(MacroCold *cold, int *maxitems, char *text, char *textend)
+{
+  if (textend <= text) {
+    return 0;
+  }
+  return addItem(cold, maxitems, ITEM_TEXT, 0, text - pool, textend - text);
+}
+
+
+
+static int paramIndex(Macro *macro, const char *token, int len)
+{
+  char *param = firstParam(macro);
+  for (int idx = 0; idx < macro->nparams; idx++, param += strlen(param) + 1) {
+    const char *name = *param != '\0' ? param : "__VA_ARGS__";
+    if (strncmp(name, token, len) == 0 && name[len] == '\0') {
+      return idx;
+    }
+  }
+  return -1;
+}
+
+
+
+/**
+ * @brief Compiles a part of the replacement text into items.
+ *
+ * Whitespace around ## is dropped, so the operands are adjacent items. The
+ * content of __VA_OPT__ is compiled into the items following it.
+ *
+ * @param macro The macro, gets the items.
+ * @param maxitems Number of items allocated.
+ * @param body Start of the part of the replacement text.
+ * @param bodyend End of the part.
+ * @return 0 on success, -1 on error.
+ */
+static int compileBody(Macro *macro, int *maxitems, char *body, char *bodyend)
+{
+  MacroCold *cold = &colds[macro - macros];
+  char *p = body, *text = body;
+  pptoken_t tok;
+
+  for (;;) {
+    char *next = lextoken(p, bodyend, &tok);
+    if (tok.kind == TK_END) {
+      break;
+    }
+    if (tokenis(&tok, "##")) {
+      char *textend = tok.start;
+      while (textend > text && ISCHAR(*(textend - 1), CH_SPACE)) {
+        textend--;
+      }
+      if (addText(cold, maxitems, text, textend) != 0 || addItem(cold, maxitems, ITEM_PASTE, 0, 0, 0) != 0) {
+        return -1;
+      }
+      p = text = skipSpaces(next, bodyend);
+      continue;
+    }
+    if (tokenis(&tok, "#")) {  // stringify, if followed by a parameter
+      pptoken_t param;
+      char *paramend = lextoken(next, bodyend, &param);
+      int idx = param.kind == TK_IDENT ? paramIndex(macro, param.start, param.len) : -1;
+      if (idx >= 0) {
+        if (addText(cold, maxitems, text, tok.start) != 0 || addItem(cold, maxitems, ITEM_STRINGIFY, idx, 0, 0) != 0) {
+          return -1;
+        }
+        next = text = paramend;
+      }
+      p = next;
+      continue;
+    }
+    if (tok.kind != TK_IDENT) {
+      p = next;
+      continue;
+    }
+    if ((macro->flags & MACRO_VARIADIC) && tokenis(&tok, "__VA_OPT__")) {
+      pptoken_t paren;
+      char *open = lextoken(next, bodyend, &paren), *close = NULL;
+      if (tokenis(&paren, "(")) {
+        char *q = open;
+        for (int depth = 1; close == NULL; ) {
+          q = lextoken(q, bodyend, &paren);
+          if (paren.kind == TK_END) {
+            break;
+          }
+          if (tokenis(&paren, "(")) {
+            depth++;
+          } else if (tokenis(&paren, ")") && --depth == 0) {
+            close = paren.start;
+          }
+        }
+      }
+      if (close == NULL) {
+        DPRINTERR("addMacro: __VA_OPT__ without (content)\n");
+        return -1;
+      }
+      if (addText(cold, maxitems, text, tok.start) != 0 || addItem(cold, maxitems, ITEM_VAOPT, 0, 0, 0) != 0) {
+        return -1;
+      }
+      int at = cold->nitems - 1;
+      if (compileBody(macro, maxitems, open, close) != 0) {
+        return -1;
+      }
+      cold->items[at].len = cold->nitems - at - 1;
+      p = text = close + 1;
+      continue;
+    }
+    int idx = paramIndex(macro, tok.start, tok.len);
+    if (idx >= 0) {
+      if (addText(cold, maxitems, text, tok.start) != 0 || addItem(cold, maxitems, ITEM_PARAM, idx, 0, 0) != 0) {
+        return -1;
+      }
+      text = next;
+    }
+    p = next;
+  }
+  return addText(cold, maxitems, text, bodyend);
+}
+
+
+
+/**
+ * @brief Compiles the replacement text of a macro.
+ *
+ * Parameters next to ## are substituted as written. The replacement text of
+ * a simple macro is pasted here into its own buffer, it needs no items. The
+ * text in the pool stays as written, for the redefinition check and -dM.
+ *
+ * @return 0 on success, -1 on error.
+ */
+static int compileMacro(Macro *macro)
+{
+  MacroCold *cold = &colds[macro - macros];
+  char *body = pool + macro->body;
+  int maxitems = 0;
+
+  if (!(macro->flags & MACRO_FUNCLIKE) && strstr(body, "##") == NULL) {
+    return 0;
+  }
+  if (compileBody(macro, &maxitems, body, body + strlen(body)) != 0) {
+    return -1;
+  }
+  for (int i = 0; i < cold->nitems; i++) {
+    MacroItem *item = &cold->items[i];
+    if (item->kind == ITEM_PARAM && ((i > 0 && (item - 1)->kind == ITEM_PASTE)
+                                     || (i + 1 < cold->nitems && (item + 1)->kind == ITEM_PASTE))) {
+      item->kind = ITEM_RAWPARAM;
+    }
+  }
+  if (!(macro->flags & MACRO_FUNCLIKE)) {  // paste now
+    int len = strlen(body);
+    cold->pasted = xmalloc(ALLOC_MACRO, len + 1);
+    if (cold->pasted == NULL) {
+      return -1;
+    }
+    char *end = substitute(macro, NULL, 0, cold->pasted, cold->pasted + len + 1);
+    *end = '\0';  // never longer than the replacement text
+    xfree(ALLOC_MACRO, cold->items);
+    cold->items = NULL;
+    cold->nitems = 0;
+  }
+  return 0;
+}
+
+
+
+static void freeCold(MacroCold *cold)
+{
+  if (cold->cache != NULL) {
+    xfree(ALLOC_MACRO, cold->cache->text);
+    xfree(ALLOC_MACRO, cold->cache);
+  }
+  xfree(ALLOC_MACRO, cold->items);
+  xfree(ALLOC_MACRO, cold->pasted);
+  memset(cold, 0, sizeof(MacroCold));
+}
+
+
+
+/**
+ * @brief Searches the chain of the bucket of the name hash, invalid macros included.
+ */
+static Macro *lookupMacro(const char *name, int len)
+{
+  unsigned hash = fullHash(name, len);
+  for (int idx = buckets[hash & (nbuckets - 1)]; idx >= 0; idx = macros[idx].next) {
+    Macro *macro = &macros[idx];
+    if (macro->hash == hash && macro->namelen == len && memcmp(pool + macro->name, name, len) == 0) {
+      return macro;
+    }
+  }
+  return NULL;
+}
+
+
+
+/**
+ * @brief Reports a diagnostic at the current line, "file:line: severity: message".
+ */
+static void diagnose(const char *severity, const char *fmt, ...)
+{
+  instream_t *in = getcurrentinstream();
+  va_list ap;
+
+  fprintf(stderr, "%s:%d: %s: ", in != NULL ? in->fname : "<command line>", in != NULL ? getlinenumber(in) : 0,
+          severity);
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+}
+
+
+
+/**
+ * @brief Parses the name of a macro definition and stores the rest of it raw.
+ *
+ * This function parses the input buffer to extract the macro name. It starts by finding the beginning of the
+ * macro name and then searches for the end of the macro name, which must be a valid identifier followed by a
+ * '(' or a space. If the macro name is not valid or if there is no '(' or space after it, the function returns
+ * -1 to indicate an error.
+ *
+ * A functional macro has the flag MACRO_FUNCLIKE, its parameter list and replacement text are appended to the
+ * string pool as written, behind the name. The replacement text of a simple macro is appended without the
+ * preceding spaces. The macro gets the flag MACRO_RAW, the parameters are parsed and the replacement text is
+ * compiled by parseMacro() when it is used first. If the pool can not be grown, the function returns -1 to
+ * indicate an error.
+ *
+ * @param buf The input buffer containing the macro definition.
+ * @param macro The record of the new macro.
+ * @return 0 if the definition was successfully parsed, -1 if there was an error.
+ *
+ * @startuml
+ *
+ * start
+ * :Find beginning of macro name;
+ * :Search for end of macro name;
+ * if (Macro name is not valid or no '(' or space after it) then
+ *   :Return -1;
+ * endif
+ * :Append name to pool;
+ * if (A '(' is found after the macro name) then
+ *   :Append parameter list and replacement text to pool;
+ * else
+ *   :Remove preceding spaces;
+ *   :Append replacement text to pool;
+ * endif
+ * :Mark macro as raw;
+ * :Return 0;
+ * stop
+ *
+ * @enduml
+ */
+static int parseDefine(char *buf, Macro *macro)
+{
+  char *end = buf + strlen(buf);
+  pptoken_t tok;
+
+  // the macro name has to be an identifier and there has to be a '(' or a space after it
+  buf = lextoken(buf, end, &tok);
+  char type = *buf, *name = tok.start;
+  if (tok.kind != TK_IDENT || (type != '(' && type != '\0' && !ISCHAR(type, CH_SPACE))) {
+    diagnose("error", "macro names must be identifiers");
+    return -1;
+  }
+  macro->namelen = tok.len;
+  macro->hash = fullHash(name, macro->namelen);
+  macro->name = poolAdd(name, macro->namelen);
+  if (macro->name == POOL_ERROR) {
+    return -1;
+  }
+  macro->flags = MACRO_RAW;
+  if (type == '(') {
+    macro->flags |= MACRO_FUNCLIKE;
+  } else {
+    buf = skipSpaces(buf, end);  // remove preciding spaces before the replacement text
+  }
+  macro->body = poolAdd(buf, end - buf);
+  return macro->body == POOL_ERROR ? -1 : 0;
+}
+
+
+
+/**
+ * @brief Parses the parameter list of a raw functional macro in place.
+ *
+ * The parameter list and the replacement text follow the name in the pool.
+ * The parameter names are moved behind the name, each terminated, and the
+ * replacement text without the preceding spaces follows them. The bytes
+ * saved are counted as unused. A parameter "..." is stored as an empty name,
+ * it stands for __VA_ARGS__.
+ *
+ * @return 0 on success, -1 if the parameter list is malformed.
+ */
+static int parseParams(Macro *macro)
+{
+  char *buf = pool + macro->body, *end = buf + strlen(buf);
+  char *out = firstParam(macro);  // the parameter list starts here, the output never overtakes the input
+
+  pptoken_t tok;
+
+  buf = lextoken(buf, end, &tok);  // '('
+  for (;;) {
+    // the parameter name has to be an identifier, "..." or "name..." for variable arguments
+    char *name = buf;
+    int len = 0;
+    buf = lextoken(buf, end, &tok);
+    if (tok.kind == TK_IDENT) {
+      name = tok.start;
+      len = tok.len;
+      buf = lextoken(buf, end, &tok);
+    }
+    if (tokenis(&tok, "...")) {
+      macro->flags |= MACRO_VARIADIC;
+      buf = lextoken(buf, end, &tok);
+    }
+    int close = tokenis(&tok, ")"), comma = tokenis(&tok, ",");  // before the name is moved over it
+    if (!close && !comma) {
+      return -1;    /** @todo error no ')' */
+    }
+    if (len > 0 || (macro->flags & MACRO_VARIADIC)) {
+      if (macro->nparams == 255) {
+        return -1;
+      }
+      memmove(out, name, len);
+      out += len;
+      *out++ = '\0';
+      macro->nparams++;
+    } else if (!close || macro->nparams > 0) {
+      return -1;    /** @todo error empty parameter name */
+    }
+    if (close) {
+      break;
+    }
+    if (macro->flags & MACRO_VARIADIC) {
+      return -1;    /** @todo  error parameter after ... */
+    }
+  }
+  // remove preciding spaces before the replacement text
+  buf = skipSpaces(buf, end);
+  memmove(out, buf, end - buf + 1);
+  macro->body = out - pool;
+  poolfree += buf - out;
+  return 0;
+}
+
+
+
+/**
+ * @brief Parses the parameters and compiles the replacement text of a raw macro.
+ *
+ * A macro whose definition turns out to be malformed gets the flag
+ * MACRO_INVALID, it is not found any more but stays in the table until it is
+ * undefined. The pool is not grown, so pointers into it stay valid.
+ *
+ * @return 0 on success, -1 if the definition is malformed.
+ */
+static int parseMacro(Macro *macro)
+{
+  int err = (macro->flags & MACRO_FUNCLIKE) ? parseParams(macro) : 0;
+
+  macro->flags &= ~MACRO_RAW;
+  if (err != 0) {
+    macro->nparams = 0;  // the body still starts at the garbled parameter list
+  }
+  if (err != 0 || compileMacro(macro) != 0) {
+    DPRINTERR("parseMacro: invalid definition of %s\n", pool + macro->name);
+    freeCold(&colds[macro - macros]);
+    macro->flags |= MACRO_INVALID;
+    return -1;
+  }
+  colds[macro - macros].bodyhash = normalHash(pool + macro->body);
+  STATS_INC(macroparses);
+  return 0;
+}
+
+
+
+/**
+ * @brief Checks if two parsed macros have the same parameters and the same replacement text.
+ *
+ * The hashes of the replacement texts are compared before the texts,
+ * whitespace separating tokens compares equal to any other whitespace.
+ */
+static int sameDefinition(Macro *a, Macro *b)
+{
+  const int kind = MACRO_FUNCLIKE | MACRO_VARIADIC | MACRO_BUILTIN;
+
+  if ((a->flags & kind) != (b->flags & kind) || a->nparams != b->nparams
+      || colds[a - macros].bodyhash != colds[b - macros].bodyhash) {
+    return 0;
+  }
+  unsigned len = nameBlockLen(a);
+  if (len != nameBlockLen(b) || memcmp(pool + a->name, pool + b->name, len) != 0) {
+    return 0;
+  }
+  const char *texta = pool + a->body, *textb = pool + b->body;
+  int statea = 0, stateb = 0, c;
+  do {
+    c = normalChar(&texta, &statea);
+  } while (c == normalChar(&textb, &stateb) && c != 0);
+  return c == 0;
+}
+
+
+
+/**
+ * @brief Handles the redefinition of a macro by the new record behind the table.
+ *
+ * An identical redefinition is dropped. A differing one replaces the macro
+ * in place, the old strings are counted as unused and the expansions
+ * memoized for the name are invalidated. The strings of a dropped record
+ * are removed from the pool, with the bytes its parsing counted as unused.
+ * A malformed redefinition is reported as error and dropped as well.
+ *
+ * @return 0 on success, -1 if the redefinition is malformed.
+ */
+static int redefineMacro(Macro *macro, unsigned mark)
+{
+  Macro *newmacro = &macros[nmacros];
+  int idx = macro - macros;
+
+  if (macro->flags & MACRO_RAW) {
+    parseMacro(macro);
+  }
+  unsigned freemark = poolfree;
+  int err = parseMacro(newmacro);
+  if (err != 0) {
+    diagnose("error", "\"%s\" redefined with a malformed definition", pool + macro->name);
+  }
+  if (err != 0 || (!(macro->flags & MACRO_INVALID) && sameDefinition(macro, newmacro))) {
+    freeCold(&colds[nmacros]);  // malformed or identical, keep the macro as it is
+    poolused = mark;
+    poolfree = freemark;
+    return err;
+  }
+  diagnose("warning", "\"%s\" redefined", pool + macro->name);
+  poolfree += nameBlockLen(macro) + strlen(pool + macro->body) + 1;
+  freeCold(&colds[idx]);
+  int next = macro->next;
+  *macro = *newmacro;
+  macro->next = next;
+  colds[idx] = colds[nmacros];
+  memset(&colds[nmacros], 0, sizeof(MacroCold));
+  touchName(macro);
+  if (poolfree > 4096 && poolfree > poolused / 2) {
+    compactPool();
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief Adds a macro to the macro table.
+ *
+ * The definition is stored as written and parsed when the macro is expanded
+ * first, most macros of the system headers are never expanded.
+ *
+ * @param buf The definition, the name followed by the parameters and the replacement text.
+ * @return 0 on success, -1 on error.
+ */
+int addMacro(char *buf)
+{
+  unsigned mark = poolused;
+
+  if (growTable() != 0) {
+    return -1;
+  }
+  Macro *macro = &macros[nmacros];
+  memset(macro, 0, sizeof(Macro));
+  macro->next = -1;
+  if (parseDefine(buf, macro) != 0) {
+    poolused = mark;  // drop the strings of the macro
+    return -1;
+  }
+  Macro *old = nmacros > 0 ? lookupMacro(pool + macro->name, macro->namelen) : NULL;
+  if (old != NULL) {
+    return redefineMacro(old, mark);
+  }
+  linkMacro(nmacros++);
+  touchName(macro);
+  prefilterAdd(pool + macro->name);
+  return 0;
+}
+
+
+
+/**
+ * @brief Adds the builtin macros __FILE__, __LINE__, __COUNTER__, __DATE__ and __TIME__.
+ *
+ * A builtin has an empty replacement text, its text is made when it is
+ * expanded. Like any other macro it can be undefined or redefined.
+ *
+ * @return 0 on success, -1 if out of memory.
+ */
+int addBuiltinMacros()
+{
+  static const char *names[] = { "__FILE__", "__LINE__", "__COUNTER__", "__DATE__", "__TIME__" };
+
+  for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+    if (addMacro((char *)names[i]) != 0) {
+      return -1;
+    }
+    Macro *macro = lookupMacro(names[i], strlen(names[i]));
+    macro->flags = MACRO_BUILTIN;
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief Deletes a macro from the macro table.
+ * 
+ * This function takes the name of a macro and deletes it from the macro table.
+ * The strings of the macro in the pool are counted as unused, the pool is
+ * compacted once half of it is unused. The last record of the table is moved
+ * into the place of the deleted one. If the macro is not found in the table,
+ * it returns -1.
+ * 
+ * @param name Name of the macro to delete.
+ * @return 0 if the macro was successfully deleted, -1 if the macro was not found.
+ * 
+ * @startuml
+ * start
+ * :Find macro by name;
+ * if (macro not found) then (yes)
+ *   :Return -1;
+ *   stop
+ * endif
+ * :Unlink macro from its bucket;
+ * :Free cold data;
+ * :Move last macro into its place;
+ * if (half of the pool unused) then (yes)
+ *   :Compact pool;
+ * endif
+ * :Return 0;
+ * stop
+ * @enduml
+ */
+int deleteMacro(char *name)
+{
+  Macro *macro = nmacros > 0 ? lookupMacro(name, strlen(name)) : NULL;
+  if (macro == NULL) {
+    return -1;
+  }
+  int idx = macro - macros, last = nmacros - 1;
+
+  touchName(macro);
+  prefilterRemove(pool + macro->name);
+  poolfree += nameBlockLen(macro) + strlen(pool + macro->body) + 1;
+  int *link = findLink(idx);
+  *link = macro->next;
+  freeCold(&colds[idx]);
+  if (idx != last) {  // move the last macro into the gap
+    *findLink(last) = idx;
+    macros[idx] = macros[last];
+    colds[idx] = colds[last];
+    memset(&colds[last], 0, sizeof(MacroCold));
+  }
+  nmacros--;
+  if (poolfree > 4096 && poolfree > poolused / 2) {
+    compactPool();
+  }
+  return 0;
+}
+
+
+
+/**
+ * @brief Releases all macros and expansion profiles.
+ */
+void freeMacroList()
+{
+  for (int i = 0; i < nmacros; i++) {
+    freeCold(&colds[i]);
+  }
+  xfree(ALLOC_MACRO, macros);
+  xfree(ALLOC_MACRO, colds);
+  xfree(ALLOC_MACRO, buckets);
+  xfree(ALLOC_MACRO, pool);
+  macros = NULL;
+  colds = NULL;
+  buckets = NULL;
+  pool = NULL;
+  nmacros = maxmacros = 0;
+  nbuckets = poolsize = poolused = poolfree = 0;
+  memset(prefilter, 0, sizeof(prefilter));
+  memset(prefiltercount, 0, sizeof(prefiltercount));
+  while (profileList != NULL) {
+    MacroProfile *prof = profileList;
+    profileList = prof->next;
+    xfree(ALLOC_REPORT, prof->name);
+    xfree(ALLOC_REPORT, prof);
+  }
+  for (int i = 0; i < MAX_NESTING; i++) {
+    xfree(ALLOC_EXPAND, scratch[i].buf);
+    xfree(ALLOC_EXPAND, scratch[i].args);
+    scratch[i].buf = NULL;
+    scratch[i].args = NULL;
+    scratch[i].size = scratch[i].maxargs = 0;
+  }
+}
+
+
+
+/**
+ * @brief Finds a macro in the macro table.
+ *
+ * This function searches the chain of the bucket of the name hash for a
+ * macro with the given name. A macro with a malformed definition is not
+ * found.
+ *
+ * @param start The start of the name.
+ * @param end The end of the name.
+ * @return A pointer to the Macro node if the macro is found, NULL otherwise.
+ */
+Macro *findMacro(char *start, char *end)
+{
+  STATS_INC(lookups);
+  if (end <= start || nmacros == 0) {
+    return NULL;
+  }
+  int len = end - start;
+  unsigned key = prefilterKey(start, len);
+  if (!(prefilter[key / 64] & (1ULL << (key % 64)))) {  // no macro has a name like this
+    STATS_INC(prefiltered);
+    return NULL;
+  }
+  Macro *macro = lookupMacro(start, len);
+  if (macro == NULL || (macro->flags & MACRO_INVALID)) {
+    return NULL;
+  }
+  STATS_INC(hits);
+  return macro;
+}
+
+
+
+/**
+ * @brief Checks if a macro is defined.
+ * 
+ * This function takes a pointer to the start and end of a macro name in a buffer.
+ * It uses the findMacro function to search for the macro in the macro list.
+ * If the macro is found, it returns 1; otherwise, it returns 0.
+ * 
+ * @param start Pointer to the start of the macro name in the buffer.
+ * @param end Pointer to the end of the macro name in the buffer.
+ * @return 1 if the macro is defined, 0 otherwise.
+ */
+int isdefinedMacro(char *start, char *end)
+{
+  return findMacro(start, end) != NULL;
+}
+
+
+
+/**
+ * @brief Replaces a portion of a buffer with a given string.
+ * 
+ * This function takes pointers to the start and end of a buffer, a pointer to the portion
+ * of the buffer to be replaced, and a replacement string. It replaces the portion of the
+ * buffer starting at `buf` and ending at the end of the string in the buffer with the
+ * replacement string. If the buffer is too small to hold the replacement string and the
+ * remaining contents of the buffer, it returns NULL.
+ * 
+ * @param start Pointer to the start of the buffer.
+ * @param buf Pointer to the portion of the buffer to be replaced.
+ * @param end Pointer to the end of the buffer.
+ * @param replace The replacement string.
+ * @return Pointer to the character immediately after the replacement string in the buffer, or NULL if the buffer is too small.
+ */
+char *replaceBuf(char *start, char *buf, char *end, char *replace)
+{
+  char * endstr = buf + strlen(buf) + 1;
+  if (replace == NULL) {
+    replace = "";
+  }
+  int rlen = strlen(replace);
+
+  if (start + rlen + (endstr - buf) >= end) {  // buffer too small
+    return NULL;
+  }
+
+  memmove(start + rlen, buf, endstr - buf);
+  memcpy(start, replace, rlen);
+
+  return start + rlen;
+}
+
+
+
+/**
+ * @brief Finds the end of a macro argument.
+ *
+ * The argument ends at a ',' or ')' outside of parentheses, commas inside of
+ * literals or nested parentheses belong to it.
+ *
+ * @param buf Pointer to the start of the argument.
+ * @param end Pointer to the end of the buffer.
+ * @param rest 1 if the argument takes the remaining arguments, their commas included.
+ * @param argend Gets the end of the last token of the argument.
+ * @return Pointer to the ',' or ')' ending the argument, or NULL at the end of the text.
+ */
+static char *findEndOfParameter(char *buf, char *end, int rest, char **argend)
+{
+  pptoken_t tok;
+  int depth = 0;
+
+  *argend = buf;
+  for (;;) {
+    char *next = lextoken(buf, end, &tok);
+    if (tok.kind == TK_END) {
+      return NULL;
+    }
+    if (tok.kind == TK_PUNCT && tok.len == 1) {
+      char c = *tok.start;
+      if (depth == 0 && (c == ')' || (c == ',' && !rest))) {
+        return tok.start;
+      }
+      depth += c == '(' ? 1 : c == ')' ? -1 : 0;
+    }
+    buf = *argend = next;
+  }
+}
+
+
+
+static long long nanotime()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+
+/**
+ * @brief Records an expansion in the macro's profile.
+ *
+ * The profile is looked up by name on the first expansion of a macro, so
+ * definitions that are never expanded do not cost anything.
+ *
+ * @param macro The expanded macro.
+ * @param argc Number of arguments of the invocation.
+ * @param len Length of the replacement.
+ * @param start Timestamp of the begin of the expansion.
+ */
+static void profileExpansion(Macro *macro, int argc, int len, long long start)
+{
+  MacroCold *cold = &colds[macro - macros];
+  MacroProfile *prof = cold->profile;
+  if (prof == NULL) {
+    for (prof = profileList; prof != NULL; prof = prof->next) {
+      if (strcmp(prof->name, pool + macro->name) == 0) {
+        break;
+      }
+    }
+    if (prof == NULL) {
+      prof = xcalloc(ALLOC_REPORT, 1, sizeof(MacroProfile));
+      if (prof == NULL) {
+        return;
+      }
+      prof->name = xstrdup(ALLOC_REPORT, pool + macro->name);
+      prof->next = profileList;
+      profileList = prof;
+    }
+    cold->profile = prof;
+  }
+  prof->count++;
+  prof->outbytes += len;
+  prof->argc[argc < PROFILE_ARGC ? argc : PROFILE_ARGC - 1]++;
+  prof->ns += nanotime() - start;
+}
+
+
+
+static int cmpProfile(const void *a, const void *b)
+{
+  const MacroProfile *x = *(MacroProfile * const *)a, *y = *(MacroProfile * const *)b;
+  if (x->ns != y->ns) {
+    return x->ns < y->ns ? 1 : -1;
   }
-  return buf;
+  return strcmp(x->name, y->name);
+}
+
+
+
+/**
+ * @brief Prints the expansion profile of all expanded macros, most expensive first.
+ *
+ * @param out The stream to print to.
+ */
+void printMacroProfile(FILE *out)
+{
+  int n = 0;
+  long long total = 0;
+  for (MacroProfile *prof = profileList; prof != NULL; prof = prof->next) {
+    n++;
+    total += prof->ns;
+  }
+  MacroProfile **sorted = xmalloc(ALLOC_REPORT, sizeof(MacroProfile *) * (n + 1));
+  if (sorted == NULL) {
+    return;
+  }
+  n = 0;
+  for (MacroProfile *prof = profileList; prof != NULL; prof = prof->next) {
+    sorted[n++] = prof;
+  }
+  qsort(sorted, n, sizeof(MacroProfile *), cmpProfile);
+
+  fprintf(out, "%-32s %10s %10s %6s %12s %8s %5s %6s  %s\n", "macro", "count", "time ms", "%",
+          "out bytes", "avg out", "depth", "avg", "args:count");
+  for (int i = 0; i < n; i++) {
+    MacroProfile *prof = sorted[i];
+    fprintf(out, "%-32s %10lu %10.3f %6.1f %12lu %8.1f %5d %6.2f ", prof->name, prof->count, prof->ns / 1e6,
+            total ? 100.0 * prof->ns / total : 0.0, prof->outbytes, (double)prof->outbytes / prof->count,
+            prof->maxdepth, (double)prof->sumdepth / prof->count);
+    for (int a = 0; a < PROFILE_ARGC; a++) {
+      if (prof->argc[a] != 0) {
+        fprintf(out, " %d%s:%lu", a, a == PROFILE_ARGC - 1 ? "+" : "", prof->argc[a]);
+      }
+    }
+    fprintf(out, "\n");
+  }
+  xfree(ALLOC_REPORT, sorted);
+}
+
+
+
+/**
+ * @brief Compares two macros by name for qsort().
+ */
+static int cmpMacroName(const void *a, const void *b)
+{
+  return strcmp(pool + macros[*(const int *)a].name, pool + macros[*(const int *)b].name);
+}
+
+
+
+/**
+ * @brief Prints all defined macros as #define lines, sorted by name.
+ *
+ * Raw macros are parsed first, so all definitions are printed in the same
+ * form: the parameters separated by ", " and the replacement text as written,
+ * ## not pasted, with its whitespace normalized. Builtin and malformed macros
+ * are not printed.
+ *
+ * @param out The stream to print to.
+ * @return 0 on success, -1 if out of memory.
+ */
+int dumpMacros(FILE *out)
+{
+  int *sorted = xmalloc(ALLOC_REPORT, sizeof(int) * (nmacros + 1));
+  if (sorted == NULL) {
+    return -1;
+  }
+  int n = 0;
+  for (int i = 0; i < nmacros; i++) {
+    if ((macros[i].flags & MACRO_RAW) && parseMacro(&macros[i]) != 0) {
+      continue;
+    }
+    if (!(macros[i].flags & (MACRO_INVALID | MACRO_BUILTIN))) {
+      sorted[n++] = i;
+    }
+  }
+  qsort(sorted, n, sizeof(int), cmpMacroName);
+
+  for (int i = 0; i < n; i++) {
+    Macro *macro = &macros[sorted[i]];
+    fprintf(out, "#define %s", pool + macro->name);
+    if (macro->flags & MACRO_FUNCLIKE) {
+      char *param = firstParam(macro);
+      fputc('(', out);
+      for (int p = 0; p < macro->nparams; p++, param += strlen(param) + 1) {
+        int variadic = p == macro->nparams - 1 && (macro->flags & MACRO_VARIADIC);
+        fprintf(out, "%s%s%s", p > 0 ? ", " : "", param, variadic ? "..." : "");
+      }
+      fputc(')', out);
+    }
+    const char *text = pool + macro->body;
+    int state = 0, c;
+    if (*text != '\0') {
+      fputc(' ', out);
+    }
+    while ((c = normalChar(&text, &state)) != 0) {
+      fputc(c, out);
+    }
+    fputc('\n', out);
+  }
+  xfree(ALLOC_REPORT, sorted);
+  return 0;
+}
+
+
+
+/**
+ * @brief Records an expansion in the trace if it took at least trace_threshold ns.
+ *
+ * @param macro The expanded macro.
+ * @param start Timestamp of the begin of the expansion.
+ */
+static void traceExpansion(Macro *macro, long long start)
+{
+  if (trace_now() - start >= trace_threshold) {
+    trace_complete("expand", pool + macro->name, macro->namelen, start);
+  }
+}
+
+
+
+/**
+ * @brief Moves the ends of the regions of the innermost scan after a replacement.
+ *
+ * @param pos Start of the replaced text.
+ * @param used Length of the replaced text.
+ * @param len Length of the replacement.
+ */
+static void shiftRegions(char *pos, int used, int len)
+{
+  for (int i = scanbase; i < nregions; i++) {
+    if (pos + used > regions[i].end) {  // replaced text reached beyond the region
+      regions[i].end = pos + len;
+      regions[i].depbase = -1;
+    } else {
+      regions[i].end += len - used;
+    }
+  }
+}
+
+
+
+/**
+ * @brief Finds the innermost region of the macro, -1 if the macro is not being expanded.
+ */
+static int activeRegion(Macro *macro)
+{
+  for (int i = nregions - 1; i >= 0; i--) {
+    if (regions[i].macro == macro) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+
+/**
+ * @brief Collects the arguments of a function-like macro invocation.
+ *
+ * The variadic parameter takes all remaining arguments including the commas,
+ * it is empty if the invocation has no argument for it.
+ *
+ * @param macro The invoked macro.
+ * @param bufp Pointer to the '(' of the invocation, set behind the ')'.
+ * @param end End of the buffer.
+ * @param sc Scratch of the nesting level, gets the arguments.
+ * @return Number of arguments, MACRO_UNCLOSED if the text ends before the ')',
+ *         or -1 on error.
+ */
+static int collectArgs(Macro *macro, char **bufp, char *end, Scratch *sc)
+{
+  char *buf = *bufp;
+  int nparams = macro->nparams, argc = 0;
+
+  buf = skipSpaces(buf, end);  // the '(', checked by processMacro()
+  if (sc->maxargs < nparams) {
+    MacroArg *args = xrealloc(ALLOC_EXPAND, sc->args, nparams * sizeof(MacroArg));
+    if (args == NULL) {
+      return -1;
+    }
+    sc->args = args;
+    sc->maxargs = nparams;
+  }
+  buf++;
+  for (;;) {
+    char *argstart = skipSpaces(buf, end), *argend;
+    int rest = argc == nparams - 1 && (macro->flags & MACRO_VARIADIC);  // takes the remaining arguments
+    buf = findEndOfParameter(argstart, end, rest, &argend);
+    if (buf == NULL) {  // the arguments continue behind the end of the text
+      return MACRO_UNCLOSED;
+    }
+    if (argc == nparams) {
+      if (nparams > 0) {  // error too many parameters
+        DPRINTERR("processMacro: error too many parameters\n");
+        return -1;
+      }
+      if (argend != argstart || *buf != ')') {  // functional macro without parameter
+        DPRINTERR("processMacro: error no parameter expected\n");
+        return -1;  // error extra parameter in functional macro not expected
+      }
+    } else {
+      MacroArg *arg = &sc->args[argc++];
+      arg->raw = argstart;
+      arg->rawlen = argend - argstart;
+      arg->expanded = NULL;
+      arg->explen = 0;
+    }
+    if (*buf++ == ')') {
+      break;
+    }
+  }
+  if (argc < nparams) {
+    if (argc < nparams - 1 || !(macro->flags & MACRO_VARIADIC)) {  // error not enough parameters
+      DPRINTERR("processMacro: error not enough parameters\n");
+      return -1;
+    }
+    MacroArg *arg = &sc->args[argc++];  // no variable arguments
+    arg->raw = buf;
+    arg->rawlen = 0;
+    arg->expanded = NULL;
+    arg->explen = 0;
+  }
+  *bufp = buf;
+  return argc;
+}
+
+
+
+/**
+ * @brief Expands the marked arguments, each once, into the scratch buffer.
+ *
+ * An argument without identifiers is used as written.
+ *
+ * @return Pointer behind the expanded arguments, or NULL on error.
+ */
+static char *expandArgs(MacroArg *args, int argc, char *out, char *outend, int ifclausemode)
+{
+  for (int i = 0; i < argc; i++) {
+    MacroArg *arg = &args[i];
+    if (arg->expanded == NULL) {
+      continue;
+    }
+    pptoken_t tok;
+    char *p = arg->raw;
+    do {
+      p = lextoken(p, arg->raw + arg->rawlen, &tok);
+    } while (tok.kind != TK_END && tok.kind != TK_IDENT);
+    if (tok.kind != TK_IDENT) {
+      arg->explen = arg->rawlen;
+      continue;
+    }
+    if (arg->rawlen >= outend - out) {
+      return NULL;
+    }
+    memcpy(out, arg->raw, arg->rawlen);
+    out[arg->rawlen] = '\0';
+    if (processBuffer(out, outend - out, ifclausemode) != 0) {
+      return NULL;
+    }
+    arg->expanded = out;
+    arg->explen = strlen(out);
+    out += arg->explen + 1;
+  }
+  return out;
+}
+
+
+
+/**
+ * @brief Formats __DATE__ and __TIME__, once per run.
+ *
+ * If SOURCE_DATE_EPOCH is set, its time is used in UTC instead of the
+ * current local time, for reproducible output.
+ */
+static void initBuiltinTime()
+{
+  const char *epoch = getenv("SOURCE_DATE_EPOCH");
+  char *end = NULL;
+  time_t now = time(NULL);
+  struct tm *tm = NULL;
+
+  if (epoch != NULL && *epoch != '\0') {
+    long long seconds = strtoll(epoch, &end, 10);
+    if (*end == '\0' && seconds >= 0) {
+      now = (time_t)seconds;
+      tm = gmtime(&now);
+    }
+  }
+  if (tm == NULL) {
+    tm = localtime(&now);
+  }
+  if (tm == NULL || strftime(builtindate, sizeof(builtindate), "\"%b %e %Y\"", tm) == 0
+      || strftime(builtintime, sizeof(builtintime), "\"%H:%M:%S\"", tm) == 0) {
+    strcpy(builtindate, "\"??? ?? ????\"");
+    strcpy(builtintime, "\"??:??:??\"");
+  }
+}
+
+
+
+/**
+ * @brief Replaces a builtin macro by its text.
+ *
+ * The builtins are told apart by the third char of their names. Their text
+ * changes from use to use, so no expansion containing one is memoized.
+ *
+ * @param macro The builtin.
+ * @param buf Start of the name in the buffer.
+ * @param name End of the name.
+ * @param end End of the buffer.
+ * @return 0 on success, -1 if the buffer is too small.
+ */
+static int expandBuiltin(Macro *macro, char *buf, char *name, char *end)
+{
+  instream_t *in = getcurrentinstream();
+  const char *text = "";
+  char number[24];
+
+  switch (pool[macro->name + 2]) {
+    case 'F':
+      text = in != NULL ? getfileliteral(in) : NULL;
+      text = text != NULL ? text : "\"\"";
+      break;
+    case 'L':
+      snprintf(number, sizeof(number), "%d", in != NULL ? getlinenumber(in) : 0);
+      text = number;
+      break;
+    case 'C':
+      snprintf(number, sizeof(number), "%lu", counter++);
+      text = number;
+      break;
+    default:  // 'D' or 'T'
+      if (builtindate[0] == '\0') {
+        initBuiltinTime();
+      }
+      text = pool[macro->name + 2] == 'D' ? builtindate : builtintime;
+      break;
+  }
+  for (int i = 0; i < nregions; i++) {  // the enclosing expansions are not memoized
+    regions[i].depbase = -1;
+  }
+  char *textend = replaceBuf(buf, name, end, (char *)text);
+  if (textend == NULL) {  // buffer too small
+    return -1;
+  }
+  lastExpansion.macro = macro;
+  lastExpansion.used = name - buf;
+  lastExpansion.len = textend - buf;
+  lastExpansion.cached = 1;  // nothing to rescan
+  return 0;
 }
 
 
@@ -640,141 +2126,237 @@ char *findEndOfParameter(char *buf, char *end) {
  * 
  * This function takes a pointer to a buffer and the length of the buffer.
  * It scans the buffer for a macro and replaces it with its replacement text.
- * If the macro is a functional macro, it also replaces the parameters in the
- * replacement text with their corresponding arguments. If the buffer is too small
- * to hold the replacement text and the remaining contents of the buffer, it returns -1.
+ * If the macro is a functional macro, the arguments are macro expanded first,
+ * each of them once, and the parameters in the replacement text are replaced
+ * with the expanded arguments. Operands of # and ## get the arguments as
+ * written. A macro is not expanded inside its own expansion. If the buffer is
+ * too small to hold the replacement text and the remaining contents of the
+ * buffer, it returns -1.
  * 
  * @param buf Pointer to the start of the buffer.
  * @param len Length of the buffer.
  * @param ifclausemode Flag indicating if the macro is inside an #if clause.
- * @return 0 if the macro was successfully processed, -1 if an error occurred, or the number of characters processed if no macro was found.
+ * @return 0 if the macro was successfully processed, -1 if an error occurred, MACRO_UNCLOSED if the text ends within the arguments, or the number of characters processed if no macro was found.
  */
 int processMacro(char *buf, int len, int ifclausemode)
 {
   char * const start = buf, *end = buf + len;
-  Macro *parammacrolist = NULL;
+  pptoken_t tok;
 
-  while (buf <= end && isIdent(*buf, buf - start)) {
-    buf++;
+  buf = lextoken(buf, end, &tok);
+  if (tok.kind != TK_IDENT || tok.start != start) {  // no identifier, therefore advance one token
+    return buf > start ? buf - start : 1;
   }
-  if (buf == start) {  // no valid identifier, therefore advance one char
-    return 1;
+  if (recording) {
+    addDependency(nameHash(start, buf - start));
   }
   Macro *macro = findMacro(start, buf);
-  if (macro == NULL) {  // no macro found
-    if (*buf == '(') {  // skip functional macro
-      buf = skipExpression(buf, end);
+  if (macro != NULL && (macro->flags & MACRO_RAW) && parseMacro(macro) != 0) {  // malformed, no macro
+    macro = NULL;
+  }
+  if (macro != NULL && (macro->flags & MACRO_FUNCLIKE)) {  // not invoked without '('
+    pptoken_t paren;
+    lextoken(buf, end, &paren);
+    if (!tokenis(&paren, "(")) {
+      macro = NULL;
     }
-    if (ifclausemode)
+  }
+  if (macro != NULL) {
+    int active = activeRegion(macro);
+    if (active >= 0) {  // disabled inside its own expansion
+      for (int i = active + 1; i < nregions; i++) {  // recordings inside the region depend on it
+        regions[i].depbase = -1;
+      }
+      macro = NULL;
+    }
+  }
+  if (macro == NULL) {  // no macro found
+    if (ifclausemode) {
+      shiftRegions(start, buf - start, 1);
       buf = replaceBuf(start, buf, end, "0");
+    }
     return buf - start;
   }
-  DPRINT("processMacro: found %s\n", macro->name);
-  MacroParam *param = macro->param;
-  if (param != NULL) {  // functional macro
-    Macro *parammacro = NULL;
-    // check for '(', there are no white spaces allowed
-    if (*buf != '(') {
-      DPRINT("processMacro: missing '(' for macro %s\n", macro->name);
+  DPRINT("processMacro: found %s\n", pool + macro->name);
+  STATS_INC(expansions);
+  if (macro->flags & MACRO_BUILTIN) {
+    return expandBuiltin(macro, start, buf, end);
+  }
+  long long tracestart = trace_enabled ? trace_now() : 0;
+  long long profstart = macroprofile_enabled ? nanotime() : 0;
+  int argc = 0;
+  MacroCold *cold = &colds[macro - macros];
+  if (!(macro->flags & MACRO_FUNCLIKE) && cold->cache != NULL && !ifclausemode && validCache(macro)
+      && usableCache(cold->cache)) {
+    MacroCache *cache = cold->cache;
+    if (recording) {
+      for (int i = 0; i < cache->ndeps; i++) {
+        addDependency(cache->deps[i]);
+      }
+    }
+    int used = buf - start;
+    buf = replaceBuf(start, buf, end, cache->text);
+    if (buf == NULL) {  // buffer too small
       return -1;
     }
-    buf++;
-    // int n = 0;
-    while (param != NULL) {
-      buf = skipSpaces(buf, end);
-      if (buf >= end) {
+    lastExpansion.macro = macro;
+    lastExpansion.used = used;
+    lastExpansion.len = buf - start;
+    lastExpansion.cached = 1;
+    STATS_INC(memohits);
+    if (macroprofile_enabled) {
+      profileExpansion(macro, argc, lastExpansion.len, profstart);
+    }
+    if (trace_enabled) {
+      traceExpansion(macro, tracestart);
+    }
+    return 0;
+  }
+  char *replace = cold->pasted != NULL ? cold->pasted : pool + macro->body;
+  if (macro->flags & MACRO_FUNCLIKE) {  // functional macro
+    if (scratchlevel == MAX_NESTING) {
+      DPRINTERR("processMacro: invocations nested too deep\n");
+      return -1;
+    }
+    Scratch *sc = &scratch[scratchlevel];
+    argc = collectArgs(macro, &buf, end, sc);
+    if (argc < 0) {
+      return argc;
+    }
+    if (sc->size < 4 * len) {  // room for the expanded arguments and the replacement
+      xfree(ALLOC_EXPAND, sc->buf);
+      sc->size = 0;
+      sc->buf = xmalloc(ALLOC_EXPAND, 4 * len);
+      if (sc->buf == NULL) {
         return -1;
       }
-      char *paramstart = buf;
-      buf = findEndOfParameter(buf, end);
-      if (buf >= end) {
+      sc->size = 4 * len;
+    }
+    if (!(ifclausemode && *replace == '\0')) {
+      markExpanded(macro, sc->args);
+      scratchlevel++;
+      char *out = expandArgs(sc->args, argc, sc->buf, sc->buf + sc->size, ifclausemode);
+      scratchlevel--;
+      char *text = out;
+      out = out != NULL ? substitute(macro, sc->args, argc, out, sc->buf + sc->size) : NULL;
+      if (out == NULL) {  // scratch buffer too small
         return -1;
       }
-
-      if (*buf == ')') {
-        if (param->name == NULL) {  // functional macro without parameter
-          if (buf == paramstart) {
-            break;
-          } else {
-            DPRINT("processMacro: error no parameter expected\n");
-            return -1;  // error extra parameter in functional macro not expected
-          }
-        } else {
-          if (param->next != NULL) {  // error not enough parameters
-            DPRINT("processMacro: error not enough parameters\n");
-            return -1;
-          }
-        }
-      } else if (*buf == ',') {
-        if (param->next == NULL) {  // error too many parameters
-          DPRINT("processMacro: error too many parameters\n");
-          return -1;
-        }
-      }
-      if (parammacro == NULL) {
-        parammacro = malloc(sizeof(Macro));
-        parammacrolist = parammacro;
-      } else {
-        parammacro->next = malloc(sizeof(Macro));
-        parammacro = parammacro->next;
-      }
-      parammacro->next = NULL;
-      parammacro->name = param->name;
-      parammacro->param = NULL;
-      parammacro->replace = malloc(buf - paramstart + 1);
-      memcpy(parammacro->replace, paramstart, buf - paramstart);
-      parammacro->replace[buf - paramstart] = '\0';
-
-      param = param->next;
-      buf++;
+      *out = '\0';
+      replace = text;
     }
   }
 
-  if (ifclausemode && (macro->replace == NULL || *macro->replace == '\0')) {
+  lastExpansion.macro = macro;
+  lastExpansion.used = buf - start;
+  lastExpansion.cached = 0;
+  if (ifclausemode && *replace == '\0') {
     buf = replaceBuf(start, buf, end, "0");
+    lastExpansion.len = 1;
+    if (macroprofile_enabled) {
+      profileExpansion(macro, argc, 1, profstart);
+    }
+    if (trace_enabled) {
+      traceExpansion(macro, tracestart);
+    }
     return 0;
   }
-  buf = replaceBuf(start, buf, end, macro->replace);
+  buf = replaceBuf(start, buf, end, replace);
   if (buf == NULL) {  // buffer too small
     return -1;
   }
 
-  if (parammacrolist != NULL) {
-    char *token = start;
-    while (token < buf) {
-      if (isIdent(*token, token - start)) {
-        char *tokenend = token;
-        while (tokenend < buf && isIdent(*tokenend, tokenend - token)) {
-          tokenend++;
-        }
-        Macro *parammacro = parammacrolist;
-        while (parammacro != NULL) {
-          if (strlen(parammacro->name) == (size_t)(tokenend - token)
-          && strncmp(parammacro->name, token, strlen(parammacro->name)) == 0) {
-            char *newtoken = replaceBuf(token, token + strlen(parammacro->name), end, parammacro->replace);
-            if (newtoken == NULL) {  // buffer too small
-              return -1;
-            }
-            buf += newtoken - token;
-            token = newtoken;
-            break;
-          }
-          parammacro = parammacro->next;
-        }
-      }
-      token++;
-    }
+  DLOG(DBG_TRACE, "processMacro done: %s\n", start);
+  lastExpansion.len = buf - start;
+  if (macroprofile_enabled) {
+    profileExpansion(macro, argc, lastExpansion.len, profstart);
+  }
+  if (trace_enabled) {
+    traceExpansion(macro, tracestart);
+  }
+  return 0;
+}
 
-    // free memory of parammacro's
-    for (Macro *parammacro = parammacrolist, *next; parammacro != NULL; parammacro = next) {
-      next = parammacro->next;
-      free(parammacro->replace);
-      free(parammacro);
-    }
+
+
+/**
+ * @brief Checks if a text ends in the name of a function-like macro.
+ *
+ * Such an expansion is not memoized, its last name may be invoked with
+ * arguments following the expansion, e.g. G(1) with #define G F.
+ */
+static int endsInFunclike(char *start, char *end)
+{
+  while (end > start && ISCHAR(end[-1], CH_SPACE)) {
+    end--;
+  }
+  char *name = end;
+  while (name > start && ISCHAR(name[-1], CH_IDCONT)) {
+    name--;
+  }
+  if (name == end || !ISCHAR(*name, CH_IDSTART)) {
+    return 0;
+  }
+  Macro *macro = findMacro(name, end);
+  return macro != NULL && (macro->flags & MACRO_FUNCLIKE);
+}
+
+
+
+/**
+ * @brief Leaves the innermost region, a memoizable recorded expansion is stored in its macro.
+ *
+ * Only expansions of object-like macros outside of #if clauses are recorded,
+ * a memoized one costs a single replaceBuf() and no rescan.
+ *
+ * @param keep 0 if the recording has to be dropped, e.g. after an error.
+ */
+static void popRegion(int keep)
+{
+  Region *region = &regions[--nregions];
+  if (!region->record) {
+    return;
   }
+  if (keep && region->depbase >= 0 && ndeps <= MAX_DEPS && colds[region->macro - macros].cache == NULL
+      && !endsInFunclike(region->start, region->end)) {
+    storeCache(region->macro, region->start, region->end - region->start, region->depbase);
+  }
+  if (--recording == 0) {
+    ndeps = 0;
+  }
+}
+
+
+
+/**
+ * @brief Separates the last expansion from the text around it where tokens would merge.
+ *
+ * The replacement and the text after it are written side by side, e.g. I(a)I(b)
+ * with #define I(x) x would give aI(b) and -NEG(1) with #define NEG(x) -x
+ * would give --1. A space is inserted at such a boundary and counted in
+ * lastExpansion.len.
+ *
+ * @param start Start of the scanned text.
+ * @param buf Start of the expansion.
+ * @param end End of the buffer.
+ * @return 0 on success, -1 if the buffer is too small.
+ */
+static int separateExpansion(char *start, char *buf, char *end)
+{
+  char *after = buf + lastExpansion.len;
 
-  removeDoubleHash(start, buf);
-  DPRINT("processMacro done: %s\n", start);
+  if (after > start && *after != '\0' && tokensMerge(start, after - 1, *after)) {
+    if (replaceBuf(after, after, end, " ") == NULL) {
+      return -1;
+    }
+    lastExpansion.len++;
+  }
+  if (buf > start && lastExpansion.len > 0 && tokensMerge(start, buf - 1, *buf)) {
+    if (replaceBuf(buf, buf, end, " ") == NULL) {
+      return -1;
+    }
+    lastExpansion.len++;
+  }
   return 0;
 }
 
@@ -791,38 +2373,104 @@ int processMacro(char *buf, int len, int ifclausemode)
  * 
  * @param buf Pointer to the start of the buffer.
  * @param len Length of the buffer.
- * @return 0 if the buffer was successfully processed, -1 if an error occurred.
+ * @return 0 if the buffer was successfully processed, MACRO_UNCLOSED if the
+ *         arguments of an invocation outside of any expansion continue behind
+ *         the end of the text, unclosedinvocation then points to its name and
+ *         the text before it is expanded, -1 if an error occurred.
  */
 int processBuffer(char *buf, int len, int ifclausemode)
 {
   // Scan buf to recognize macros
   char *start = buf, *end = buf + len;
-
-  while (buf < end && *buf != '\0') {
-    buf = skipSpaces(buf, end);  // skip preceding spaces
-    if (isIdent(*buf, 0)) {
-      DPRINT("processBuffer next: %.*s\n", (int)(end - buf), buf);
+  const int base = nregions;  // regions below base belong to enclosing scans
+  const int outerbase = scanbase;
+  STATS_ENTER(PH_MACRO, phase);
+
+  for (;;) {
+    pptoken_t tok;
+    char *next = lextoken(buf, end, &tok);
+    if (tok.kind == TK_END) {
+      break;
+    }
+    buf = tok.start;
+    while (nregions > base && buf >= regions[nregions - 1].end) {
+      popRegion(1);
+    }
+    if (tok.kind == TK_IDENT) {
+      DLOG(DBG_TRACE, "processBuffer next: %.*s\n", (int)(end - buf), buf);
+      scanbase = base;
       int cnt = processMacro(buf, end - buf, ifclausemode);
-      DPRINT("processBuffer next done: %s\n", buf);
+      DLOG(DBG_TRACE, "processBuffer next done: %s\n", buf);
+      if (cnt == 0 && !lastExpansion.cached && nregions == MAX_NESTING) {
+        DPRINTERR("processBuffer: expansions nested too deep\n");
+        cnt = -1;
+      }
+      if (cnt == 0 && separateExpansion(start, buf, end) != 0) {
+        cnt = -1;
+      }
+      if (cnt == 0 && scratchlevel == 0) {  // expanded arguments are counted in the replacement
+        if (nregions == 0) {  // a top-level expansion, not one rescanned inside of it
+          expansiongrowth = 0;
+        }
+        expansiongrowth += lastExpansion.len - lastExpansion.used;
+        if (expansiongrowth > 0 && bounds_check(BOUND_EXPANSION, expansiongrowth) != 0) {
+          cnt = -1;
+        }
+      }
+      if (cnt == MACRO_UNCLOSED) {
+        if (nregions == 0 && scratchlevel == 0 && !ifclausemode) {  // the caller may append the next line
+          unclosedinvocation = buf;
+          scanbase = outerbase;
+          STATS_LEAVE(phase);
+          return cnt;
+        }
+        DPRINTERR("processBuffer: invocation of %.*s not closed\n", (int)(next - buf), buf);
+        cnt = -1;
+      }
       if (cnt < 0) {
-        DPRINT("processBuffer: failed %d\n", cnt);
+        DPRINTERR("processBuffer: failed %d\n", cnt);
+        while (nregions > base) {
+          popRegion(0);
+        }
+        scanbase = outerbase;
+        STATS_LEAVE(phase);
         return cnt;
       }
+      if (cnt == 0) {  // expanded, the replacement is rescanned as nested region
+        shiftRegions(buf, lastExpansion.used, lastExpansion.len);
+        if (lastExpansion.cached) {  // memoized expansions are already rescanned
+          buf += lastExpansion.len;
+          continue;
+        }
+        Macro *macro = lastExpansion.macro;
+        Region *region = &regions[nregions++];
+        region->start = buf;
+        region->end = buf + lastExpansion.len;
+        region->macro = macro;
+        region->hash = foldHash(macro->hash);
+        region->record = !(macro->flags & MACRO_FUNCLIKE) && colds[macro - macros].cache == NULL && !ifclausemode;
+        region->depbase = ndeps;
+        if (region->record) {
+          recording++;
+        }
+        if (macroprofile_enabled && colds[macro - macros].profile != NULL) {
+          MacroProfile *prof = colds[macro - macros].profile;
+          prof->sumdepth += nregions - base;
+          if (nregions - base > prof->maxdepth) {
+            prof->maxdepth = nregions - base;
+          }
+        }
+      }
       buf += cnt;
       continue;
     }
-    // skip string
-    if (*buf == '\"' && !(buf > start && *(buf - 1) == '\\')) {
-      buf = skipString(buf, end);
-      continue;
-    }
-    // ignore char
-    if (isdigit(*buf)) {
-      buf = skipNumber(buf, end);
-      continue;
-    }
-    buf++;
+    buf = next;  // literals, numbers and punctuators are no macros
+  }
+  while (nregions > base) {
+    popRegion(1);
   }
-  DPRINT("processBuffer done: %s\n", start);
+  scanbase = outerbase;
+  DLOG(DBG_TRACE, "processBuffer done: %s\n", start);
+  STATS_LEAVE(phase);
   return 0;
 }
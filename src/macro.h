@@ -12,11 +12,26 @@
 #ifndef MACRO_H
 #define MACRO_H
 
+#include <stdio.h>
+
+struct macro;
+
+#define MACRO_UNCLOSED -2  // the arguments of an invocation continue behind the end of the text
+
+extern int macroprofile_enabled;
+extern char *unclosedinvocation;
+
 // Function prototypes
 int addMacro(char *buf);
+int addBuiltinMacros();
 int deleteMacro(char *buf);
 int processBuffer(char *buf, int len, int ifclausemode);
+int processMacro(char *buf, int len, int ifclausemode);
+struct macro *findMacro(char *start, char *end);
 void printMacroList();
+void freeMacroList();
+void printMacroProfile(FILE *out);
+int dumpMacros(FILE *out);
 int isdefinedMacro(char *start, char *end);
 int isIdent(char c, int idx);
 char *replaceBuf(char *start, char *buf, char *end, char *replace);
@@ -9,15 +9,22 @@
  * 
  */
 #define NDEBUG
+#define DBG_SUBSYSTEM DBG_MAIN
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>  // For getopt()
+#include <getopt.h>  // For getopt_long()
 
 #include "debug.h"
 #include "input.h"
 #include "macro.h"
 #include "cmdline.h"
+#include "stats.h"
+#include "trace.h"
+#include "header.h"
+#include "alloc.h"
+#include "bounds.h"
 
 /*
 write a function that takes the command line arguments and processes them
@@ -27,37 +34,210 @@ if outfile is specified with '-', stdout is used
 -Dname: Define a macro named name with a value of 1. You can also specify a value with -Dname=value.
 -Uname: Undefine the macro name.
 -Ipath: Add the directory path to the list of directories to be searched for header files.
+-dM: Process the directives only and write a #define line per macro defined at the end, sorted by name,
+     instead of the preprocessed text.
+--stats: Print timings per phase and event counters to stderr at exit.
+--trace=file: Write a timeline of includes, #if evaluations and expansions in trace event format.
+--trace-threshold=us: Only trace expansions taking at least us microseconds (default 10).
+--profile-macros[=file]: Write an expansion profile per macro to file (default stderr) at exit.
+--header-report[=file]: Write opens, skips, bytes and time per included file, sorted by inclusive
+                        time, to file (default stderr). An existing report file is merged.
+--debug=filter: Enable trace points, e.g. "macro=trace,input" or "all=info", also read from
+                $STCPP_DEBUG. The messages are kept in a ring buffer and written at exit.
+--debug-log=file: Write the debug messages to file instead of stderr.
+--unifdef: Resolve only the conditionals on the macros given by -D and -U, all others are kept as they are.
+           Text lines are not expanded, includes are not followed and #define and #undef are written as they are.
+--limits=spec: Limit resources, e.g. "include-depth=50,macro-bytes=16M,expansion-bytes=1M,memory=256M".
+               A limit of 0 is no limit, by default only the include depth is limited to 200.
 */
 
+enum longopts {
+  OPT_STATS = 256,
+  OPT_TRACE,
+  OPT_TRACE_THRESHOLD,
+  OPT_PROFILE_MACROS,
+  OPT_HEADER_REPORT,
+  OPT_DEBUG,
+  OPT_DEBUG_LOG,
+  OPT_LIMITS,
+  OPT_UNIFDEF
+};
+
+static const struct option longOptions[] = {
+  { "stats", no_argument, NULL, OPT_STATS },
+  { "trace", required_argument, NULL, OPT_TRACE },
+  { "trace-threshold", required_argument, NULL, OPT_TRACE_THRESHOLD },
+  { "profile-macros", optional_argument, NULL, OPT_PROFILE_MACROS },
+  { "header-report", optional_argument, NULL, OPT_HEADER_REPORT },
+  { "debug", required_argument, NULL, OPT_DEBUG },
+  { "debug-log", required_argument, NULL, OPT_DEBUG_LOG },
+  { "limits", required_argument, NULL, OPT_LIMITS },
+  { "unifdef", no_argument, NULL, OPT_UNIFDEF },
+  { NULL, 0, NULL, 0 }
+};
+
+/**
+ * @brief Defines a macro given by -D.
+ *
+ * The definition is "name", "name=value" or, as in a #define, "name value".
+ * A name without a value is defined as 1.
+ *
+ * @param arg The argument of -D.
+ * @return 0 on success, -1 if the definition is malformed or out of memory.
+ */
+static int defineMacro(const char *arg)
+{
+  int len = strlen(arg);
+  char *def = xmalloc(ALLOC_MACRO, len + 3);
+  if (def == NULL) {
+    return -1;
+  }
+  memcpy(def, arg, len + 1);
+  int namelen = strcspn(def, "= \t");
+  if (def[namelen] == '=') {
+    def[namelen] = ' ';
+  } else if (def[namelen] == '\0') {
+    strcpy(def + len, " 1");
+  }
+  int err = addMacro(def);
+  xfree(ALLOC_MACRO, def);
+  return err;
+}
+
+
+
+/**
+ * @brief Expands a text line, an invocation left open at its end continues on the next lines.
+ *
+ * The text before the open invocation is written, the next text line is
+ * appended to the rest and the expansion goes on. Directives between the lines
+ * of the arguments are processed as they are read, like gcc does.
+ *
+ * @param buf The text line, expanded in place.
+ * @param size Size of buf.
+ * @param outfile The output, gets the text before an open invocation.
+ * @return 0 on success, -1 on error.
+ */
+static int expandLine(char *buf, int size, FILE *outfile)
+{
+  char line[4096];
+  int err;
+
+  while ((err = processBuffer(buf, size, 0)) == MACRO_UNCLOSED) {
+    STATS_ENTER(PH_OUTPUT, phase);
+    fwrite(buf, 1, unclosedinvocation - buf, outfile);
+    STATS_LEAVE(phase);
+    memmove(buf, unclosedinvocation, strlen(unclosedinvocation) + 1);
+    for (;;) {
+      if (readline(NULL, line, sizeof(line)) != 0) {
+        DPRINTERR("expandLine: invocation not closed at the end of the input: %s\n", buf);
+        return -1;
+      }
+      if (iscmdline(line)) {
+        STATS_ENTER(PH_DIRECTIVE, phase);
+        err = processcmdline(line, sizeof(line));
+        STATS_LEAVE(phase);
+        if (err != 0 || bounds_exceeded) {
+          return -1;
+        }
+      } else if (condstate != 0) {
+        break;
+      }
+    }
+    int len = strlen(buf), linelen = strlen(line);
+    if (len + 1 + linelen >= size / 2) {  // leave room for the expansion
+      DPRINTERR("expandLine: invocation too long: %s\n", buf);
+      return -1;
+    }
+    buf[len] = ' ';
+    memcpy(buf + len + 1, line, linelen + 1);
+  }
+  return err;
+}
+
+
+
 int main(int argc, char *argv[])
 {
   int opt;
   FILE *outfile = stdout;
-  char *outfname = NULL, *infname = NULL;
+  char *outfname = NULL, *infname = NULL, *proffname = NULL, *hdrfname = NULL;
+  int dumpmacros = 0;
   // Define your supported options here. The colon after each letter indicates that the option requires an argument.
-  const char *optString = "D:U:I:";
+  const char *optString = "D:U:I:d:";
 
-  if (initsearchdirs() != 0) {
+  if (getenv("STCPP_DEBUG") != NULL && dbg_setfilter(getenv("STCPP_DEBUG")) != 0) {
+    return 1;
+  }
+  if (initsearchdirs() != 0 || addBuiltinMacros() != 0) {
     return 1;
   }
 
   char *oarg = NULL;
-  while ((opt = getopt(argc, argv, optString)) != -1) {
+  while ((opt = getopt_long(argc, argv, optString, longOptions, NULL)) != -1) {
     switch (opt) {
       case 'D':
         oarg = optarg;
         // cppcheck-suppress syntaxError
         DPRINT("Define macro: %s\n", oarg);
-        addMacro(oarg);   // @todo: addMacro() is not enough, you need to parse the optarg for name and value
-        // Here you would add code to define a macro
+        if (defineMacro(oarg) != 0) {
+          fprintf(stderr, "Invalid macro definition: -D%s\n", oarg);
+          return 1;
+        }
         break;
       case 'U':
         DPRINT("Undefine macro: %s\n", optarg);
-        // Here you would add code to undefine a macro
+        if (addundefined(optarg) != 0) {
+          return 1;
+        }
         break;
       case 'I':
         addsearchdir(optarg);
         break;
+      case 'd':
+        if (strcmp(optarg, "M") != 0) {
+          fprintf(stderr, "Unknown dump mode: -d%s\n", optarg);
+          return 1;
+        }
+        dumpmacros = 1;
+        break;
+      case OPT_STATS:
+        stats_start();
+        break;
+      case OPT_TRACE:
+        if (trace_open(optarg) != 0) {
+          return 1;
+        }
+        break;
+      case OPT_TRACE_THRESHOLD:
+        trace_threshold = atof(optarg) * 1000;
+        break;
+      case OPT_PROFILE_MACROS:
+        macroprofile_enabled = 1;
+        proffname = optarg;
+        break;
+      case OPT_HEADER_REPORT:
+        headerreport_enabled = 1;
+        hdrfname = optarg;
+        break;
+      case OPT_DEBUG:
+        if (dbg_setfilter(optarg) != 0) {
+          return 1;
+        }
+        break;
+      case OPT_DEBUG_LOG:
+        if (dbg_open(optarg) != 0) {
+          return 1;
+        }
+        break;
+      case OPT_UNIFDEF:
+        partialmode = 1;
+        break;
+      case OPT_LIMITS:
+        if (bounds_set(optarg) != 0) {
+          return 1;
+        }
+        break;
      default:
         // Handle unknown options and missing option arguments
         fprintf(stderr, "Unknown option or missing option argument: %c\n", opt);
@@ -67,13 +247,13 @@ int main(int argc, char *argv[])
 
   if (optind != argc - 2) {
     fprintf(stderr, "usage:\n");
-    fprintf(stderr, "cpp [-Dname[=value]] [-Uname] [-Ipath] infile outfile\n");
+    fprintf(stderr, "cpp [-Dname[=value]] [-Uname] [-Ipath] [-dM] [--stats] [--trace=file] [--profile-macros[=file]] [--header-report[=file]] [--debug=filter] [--debug-log=file] [--limits=spec] [--unifdef] infile outfile\n");
     return 1;
   }
   infname = argv[optind];
   outfname = argv[optind + 1];
-  DPRINT("Input file: %s\n", infname);
-  DPRINT("Output file: %s\n", outfname);
+  DLOG(DBG_INFO, "Input file: %s\n", infname);
+  DLOG(DBG_INFO, "Output file: %s\n", outfname);
   if (strcmp(outfname, "-") != 0) {
     outfile = fopen(outfname, "w");
     if (outfile == NULL) {
@@ -83,43 +263,103 @@ int main(int argc, char *argv[])
   }
 
 
-  if (newinstream(strdup(infname), 1) != 0) {
+  if (newinstream(infname, 1) != 0) {
     return 1;
   }
 
   char buf[4096];
   int rtn;
+  int failed = 0;  // an error stopped the processing
   while ((rtn = readline(NULL, buf, sizeof(buf))) == 0) {
-    instream_t *in = getcurrentinstream();
-    if (in->eof) {
-      break;
+    if (partialmode) {  // lines are written unexpanded, or dropped
+      STATS_ENTER(PH_DIRECTIVE, phase);
+      int keep = iscmdline(buf) ? partialcmdline(buf, sizeof(buf)) : condstate != 0;
+      STATS_LEAVE(phase);
+      if (keep < 0) {
+        fprintf(stderr, "Error processing command line\n");
+        failed = 1;
+        break;
+      }
+      if (keep) {
+        STATS_ENTER(PH_OUTPUT, phase);
+        fputs(buf, outfile);
+        fputc('\n', outfile);
+        STATS_LEAVE(phase);
+      }
+      continue;
     }
     if (iscmdline(buf)) {
-      if (processcmdline(buf, sizeof(buf)) != 0) {
-        printf("Error processing command line\n");
-        DPRINT("%s(%d, %d): %s\n", in->fname, in->line, in->col, strerror(in->error));
+      STATS_ENTER(PH_DIRECTIVE, phase);
+      int err = processcmdline(buf, sizeof(buf));
+      STATS_LEAVE(phase);
+      if (err != 0) {
+        fprintf(stderr, "Error processing command line\n");
+        instream_t *in = getcurrentinstream();
+        if (in != NULL) {
+          DPRINTERR("%s(%d, %d): %s\n", in->fname, in->line, in->col, strerror(in->error));
+        }
+        failed = 1;
         break;
       }
     } else {
-      DPRINT("> %1d %03d: %s\n", condstate, in->line, buf);
-      if (condstate == 0)
+      DLOG(DBG_TRACE, "> %1d %03d: %s\n", condstate, getcurrentinstream()->line, buf);
+      if (condstate == 0 || dumpmacros)  // text lines are not even expanded for -dM
         continue;
-      if (processBuffer(buf, sizeof(buf), 0) != 0) {
-        printf("Error processing buffer\n");
+      if (expandLine(buf, sizeof(buf), outfile) != 0) {
+        fprintf(stderr, "Error processing buffer\n");
+        failed = 1;
         break;
       }
+      STATS_ENTER(PH_OUTPUT, phase);
       strcat(buf, "\n");
       fputs(buf, outfile);
+      STATS_LEAVE(phase);
+    }
+    if (bounds_exceeded) {  // an operation was refused by a limit
+      break;
     }
   }
-  if (rtn < 0) {
-    printf("Error reading file\n");
+  if (rtn < 0 && getcurrentinstream() != NULL) {  // not at the end of the input
+    fprintf(stderr, "Error reading file\n");
+    failed = 1;
   }
   // printf("%s: %s\n", in.fname, strerror(in.error));
 
-#ifndef NDEBUG
   printMacroList();
-#endif
 
-  return 0;
+  STATS_ENTER(PH_OUTPUT, phase);
+  int dumperr = dumpmacros ? dumpMacros(outfile) : 0;
+  if (outfile != stdout) {
+    fclose(outfile);
+  }
+  STATS_LEAVE(phase);
+  trace_close();
+  int status = failed || bounds_exceeded || dumperr != 0 ? 1 : 0;
+  if (macroprofile_enabled) {
+    FILE *proffile = proffname != NULL ? fopen(proffname, "w") : stderr;
+    if (proffile == NULL) {
+      perror(proffname);
+      status = 1;
+    } else {
+      printMacroProfile(proffile);
+      if (proffile != stderr) {
+        fclose(proffile);
+      }
+    }
+  }
+  if (headerreport_enabled && header_report(hdrfname) != 0) {
+    status = 1;
+  }
+
+  // release everything, so the live bytes in the stats report are leaks
+  freecond();
+  releaseinput();
+  freeMacroList();
+  header_free();
+  dbg_close();
+  if (stats_enabled) {
+    stats_report(stderr);
+  }
+
+  return status;
 }
@@ -0,0 +1,157 @@
+/**
+ * @file stats.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief runtime statistics, per phase timings and event counters
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The time between two calls of stats_switch() is accounted to the phase
+ * that was active before the call, so nested phases (e.g. macro expansion
+ * inside of directive handling) are counted exclusively.
+ *
+ * Wall time is taken from CLOCK_MONOTONIC on every switch. Reading
+ * CLOCK_PROCESS_CPUTIME_ID is a system call, so it is read at most once
+ * per CPU_WINDOW of wall time and the CPU time of the window is split
+ * across the phases in proportion to their wall time in that window.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_REPORT
+#include <time.h>
+#include <sys/resource.h>
+
+#include "debug.h"
+#include "stats.h"
+#include "cmdline.h"
+#include "alloc.h"
+
+
+stats_t stats;
+int stats_enabled = 0;
+
+static const char *phasenames[PH_COUNT] = {
+  "other",
+  "lexing",
+  "directives",
+  "macro expansion",
+  "expression eval",
+  "output"
+};
+
+#define CPU_WINDOW  1000000LL   // ns
+
+static statphase_t curphase = PH_OTHER;
+static long long lastwall, lastcpu, startwall, startcpu, windowstart;
+static long long phasewall[PH_COUNT], phasecpu[PH_COUNT], windowwall[PH_COUNT];
+
+
+
+static long long nsec(clockid_t clk)
+{
+  struct timespec ts;
+  clock_gettime(clk, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+
+/**
+ * @brief enables the phase timers and starts the clocks
+ */
+void stats_start()
+{
+  stats_enabled = 1;
+  curphase = PH_OTHER;
+  startwall = lastwall = windowstart = nsec(CLOCK_MONOTONIC);
+  startcpu = lastcpu = nsec(CLOCK_PROCESS_CPUTIME_ID);
+  DPRINT("stats_start: phase timers enabled\n");
+}
+
+
+
+/**
+ * @brief distributes the CPU time of the current window across the phases
+ */
+static void closewindow(long long wall)
+{
+  long long cpu = nsec(CLOCK_PROCESS_CPUTIME_ID);
+  long long span = wall - windowstart;
+
+  for (int i = 0; i < PH_COUNT; i++) {
+    if (span > 0) {
+      phasecpu[i] += (cpu - lastcpu) * windowwall[i] / span;
+    }
+    windowwall[i] = 0;
+  }
+  lastcpu = cpu;
+  windowstart = wall;
+}
+
+
+
+/**
+ * @brief accounts the time since the last switch to the current phase and enters phase
+ *
+ * @param phase the phase to enter
+ * @return the phase active before
+ */
+statphase_t stats_switch(statphase_t phase)
+{
+  long long wall = nsec(CLOCK_MONOTONIC);
+  statphase_t prev = curphase;
+
+  phasewall[curphase] += wall - lastwall;
+  windowwall[curphase] += wall - lastwall;
+  lastwall = wall;
+  if (wall - windowstart >= CPU_WINDOW) {
+    closewindow(wall);
+  }
+  curphase = phase;
+  return prev;
+}
+
+
+
+/**
+ * @brief prints timings and counters
+ *
+ * @param out stream to print to
+ */
+void stats_report(FILE *out)
+{
+  stats_switch(curphase);
+  closewindow(lastwall);
+  long long wall = lastwall - startwall, cpu = lastcpu - startcpu;
+  struct rusage ru;
+
+  fprintf(out, "*** stcpp statistics\n");
+  fprintf(out, "%-18s %10s %6s %10s %6s\n", "phase", "wall ms", "%", "cpu ms", "%");
+  for (int i = 0; i < PH_COUNT; i++) {
+    fprintf(out, "%-18s %10.3f %6.1f %10.3f %6.1f\n", phasenames[i],
+            phasewall[i] / 1e6, wall ? 100.0 * phasewall[i] / wall : 0.0,
+            phasecpu[i] / 1e6, cpu ? 100.0 * phasecpu[i] / cpu : 0.0);
+  }
+  fprintf(out, "%-18s %10.3f %6s %10.3f\n", "total", wall / 1e6, "", cpu / 1e6);
+
+  fprintf(out, "%-18s %10lu\n", "bytes read", stats.bytes);
+  fprintf(out, "%-18s %10lu\n", "lines", stats.lines);
+  fprintf(out, "%-18s %10lu\n", "line splices", stats.splices);
+  for (int i = 0; i < STATS_DIRECTIVES; i++) {
+    if (stats.directives[i] != 0) {
+      fprintf(out, "#%-17s %10lu\n", getcmdname(i), stats.directives[i]);
+    }
+  }
+  fprintf(out, "%-18s %10lu\n", "macro lookups", stats.lookups);
+  fprintf(out, "%-18s %10lu\n", "macro hits", stats.hits);
+  fprintf(out, "%-18s %10lu\n", "prefiltered", stats.prefiltered);
+  fprintf(out, "%-18s %10lu\n", "expansions", stats.expansions);
+  fprintf(out, "%-18s %10lu\n", "memoized", stats.memohits);
+  fprintf(out, "%-18s %10lu\n", "macros parsed", stats.macroparses);
+  fprintf(out, "%-18s %10lu\n", "include opens", stats.includes);
+  fprintf(out, "%-18s %10lu\n", "search dir probes", stats.probes);
+  if (getrusage(RUSAGE_SELF, &ru) == 0) {
+    fprintf(out, "%-18s %10ld\n", "peak RSS kB", ru.ru_maxrss);
+  }
+  alloc_report(out);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file stats.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief runtime statistics, per phase timings and event counters
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+#define STATS_DIRECTIVES  16
+
+typedef enum statphase {
+  PH_OTHER,
+  PH_LEX,
+  PH_DIRECTIVE,
+  PH_MACRO,
+  PH_EXPR,
+  PH_OUTPUT,
+  PH_COUNT
+} statphase_t;
+
+
+/**
+ * @brief event counters, always enabled
+ *
+ * The counters are plain increments of global variables, cheap enough to
+ * be left enabled. Only the phase timers depend on stats_enabled.
+ */
+typedef struct stats {
+  unsigned long bytes;                            /**< bytes read from input files */
+  unsigned long lines;                            /**< physical lines read */
+  unsigned long splices;                          /**< line splices removed */
+  unsigned long directives[STATS_DIRECTIVES];     /**< directives by cmdtoken_t */
+  unsigned long lookups;                          /**< macro table lookups */
+  unsigned long hits;                             /**< successful macro table lookups */
+  unsigned long prefiltered;                      /**< lookups rejected by the name prefilter */
+  unsigned long expansions;                       /**< macro expansions */
+  unsigned long macroparses;                      /**< macro definitions parsed on first use */
+  unsigned long memohits;                         /**< expansions served from the memoized result */
+  unsigned long includes;                         /**< include files opened */
+  unsigned long probes;                           /**< search directory probes */
+} stats_t;
+
+
+extern stats_t stats;
+extern int stats_enabled;
+
+#define STATS_INC(counter)      (stats.counter++)
+#define STATS_ADD(counter, n)   (stats.counter += (n))
+
+/**
+ * @brief switches the phase time is accounted to
+ *
+ * STATS_ENTER declares save and keeps the previous phase in it,
+ * STATS_LEAVE switches back to it.
+ */
+#define STATS_ENTER(phase, save)  statphase_t save = stats_enabled ? stats_switch(phase) : PH_OTHER
+#define STATS_LEAVE(save)         do { if (stats_enabled) stats_switch(save); } while (0)
+
+void stats_start();
+statphase_t stats_switch(statphase_t phase);
+void stats_report(FILE *out);
+
+#endif  // STATS_H
@@ -0,0 +1,178 @@
+/**
+ * @file token.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief preprocessing tokens, the lexer shared by directives, expansion and #if
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The lexer splits a text into preprocessing tokens: identifiers, pp-numbers,
+ * string and character literals (with an L, u, U or u8 prefix), punctuators
+ * and other chars. A token is a span of the text with its kind and flags,
+ * nothing is copied. The text ends at end or at a '\0'.
+ *
+ * The text is lexed on demand, one token per call, as macro expansion
+ * rewrites it in place behind the current token. Directive handling,
+ * expansion and #if evaluation use the same lexer, so they agree on where
+ * literals and numbers end.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_TOKEN
+#include <string.h>
+
+#include "debug.h"
+#include "token.h"
+
+
+/**
+ * @brief char classes of all bytes, see CH_IDSTART etc.
+ *
+ * Chars are classified by the table chartype, which does not depend on the
+ * locale. Bytes from 0x80 are of no class.
+ */
+const unsigned char chartype[256] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0x20, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x00, 0x13, 0x13, 0x13, 0x13, 0x13, 0x13, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x20, 0x00, 0x20, 0x20, 0x03,
+  0x00, 0x13, 0x13, 0x13, 0x13, 0x13, 0x13, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x20, 0x20, 0x20, 0x20, 0x00,
+};
+
+static const char *puncts3[] = { "...", "<<=", ">>=" };
+static const char puncts2[] = "->++--<<>><=>===!=&&||*=/=%=+=-=&=^=|=##";
+
+
+
+/**
+ * @brief returns the length of the punctuator at p
+ */
+static int punctlen(const char *p, const char *end)
+{
+  if (end - p >= 3) {
+    for (int i = 0; i < (int)(sizeof(puncts3) / sizeof(puncts3[0])); i++) {
+      if (memcmp(p, puncts3[i], 3) == 0) {
+        return 3;
+      }
+    }
+  }
+  if (end - p >= 2) {
+    for (const char *q = puncts2; *q != '\0'; q += 2) {
+      if (p[0] == q[0] && p[1] == q[1]) {
+        return 2;
+      }
+    }
+  }
+  return 1;
+}
+
+
+
+/**
+ * @brief returns the end of the literal with the opening quote at p
+ *
+ * An unterminated literal ends with the text.
+ */
+static char *literalend(char *p, char *end)
+{
+  char quote = *p++;
+  while (p < end && *p != quote && *p != '\0') {
+    if (*p == '\\' && p + 1 < end && p[1] != '\0') {
+      p++;
+    }
+    p++;
+  }
+  return p < end && *p == quote ? p + 1 : p;
+}
+
+
+
+/**
+ * @brief lexes the next token of a text
+ *
+ * @param buf position in the text, whitespace before the token is skipped
+ * @param end end of the text
+ * @param tok gets the token, TK_END at the end of the text
+ * @return pointer behind the token
+ */
+char *lextoken(char *buf, char *end, pptoken_t *tok)
+{
+  char *p = buf;
+
+  tok->flags = 0;
+  while (p < end && ISCHAR(*p, CH_SPACE)) {
+    p++;
+  }
+  if (p != buf) {
+    tok->flags |= TF_SPACE;
+  }
+  tok->start = p;
+  if (p >= end || *p == '\0') {
+    tok->kind = TK_END;
+    tok->len = 0;
+    return p;
+  }
+  char c = *p;
+  if (ISCHAR(c, CH_IDSTART)) {
+    while (p < end && ISCHAR(*p, CH_IDCONT)) {
+      p++;
+    }
+    int len = p - tok->start;
+    int prefix = (len == 1 && (c == 'L' || c == 'u' || c == 'U')) || (len == 2 && c == 'u' && tok->start[1] == '8');
+    if (prefix && p < end && (*p == '\"' || *p == '\'')) {
+      tok->kind = *p == '\"' ? TK_STRING : TK_CHAR;
+      p = literalend(p, end);
+    } else {
+      tok->kind = TK_IDENT;
+    }
+  } else if (ISCHAR(c, CH_DIGIT) || (c == '.' && p + 1 < end && ISCHAR(p[1], CH_DIGIT))) {
+    p++;
+    while (p < end) {
+      if ((*p == '+' || *p == '-') && strchr("eEpP", *(p - 1)) != NULL) {
+        p++;
+      } else if (ISCHAR(*p, CH_IDCONT) || *p == '.') {
+        p++;
+      } else {
+        break;
+      }
+    }
+    tok->kind = TK_NUMBER;
+  } else if (c == '\"' || c == '\'') {
+    tok->kind = c == '\"' ? TK_STRING : TK_CHAR;
+    p = literalend(p, end);
+  } else if (ISCHAR(c, CH_PUNCT)) {
+    tok->kind = TK_PUNCT;
+    p += punctlen(p, end);
+  } else {
+    tok->kind = TK_OTHER;
+    DLOG(DBG_DEBUG, "lextoken: stray char 0x%02x\n", (unsigned char)c);
+    p++;
+  }
+  tok->len = p - tok->start;
+  return p;
+}
+
+
+
+/**
+ * @brief lexes the first token of a text, it gets the flag TF_BOL
+ */
+char *lexfirst(char *buf, char *end, pptoken_t *tok)
+{
+  char *next = lextoken(buf, end, tok);
+  tok->flags |= TF_BOL;
+  return next;
+}
+
+
+
+/**
+ * @brief checks if a token is the identifier or punctuator text
+ */
+int tokenis(const pptoken_t *tok, const char *text)
+{
+  return strncmp(tok->start, text, tok->len) == 0 && text[tok->len] == '\0' && tok->len > 0;
+}
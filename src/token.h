@@ -0,0 +1,51 @@
+/**
+ * @file token.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief preprocessing tokens, the lexer shared by directives, expansion and #if
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TOKEN_H
+#define TOKEN_H
+
+typedef enum tokenkind {
+  TK_END,     // end of the text
+  TK_IDENT,   // identifier
+  TK_NUMBER,  // preprocessing number
+  TK_STRING,  // string literal, with its prefix
+  TK_CHAR,    // character constant, with its prefix
+  TK_PUNCT,   // punctuator, "##", "<<=", "..." etc. are one token
+  TK_OTHER    // any other char
+} tokenkind_t;
+
+// char classes, independent of the locale
+#define CH_IDSTART   0x01  // letter or '_'
+#define CH_IDCONT    0x02  // letter, digit or '_'
+#define CH_SPACE     0x04  // ' ', '\t', '\n', '\v', '\f', '\r'
+#define CH_DIGIT     0x08  // '0'..'9'
+#define CH_XDIGIT    0x10  // hexadecimal digit
+#define CH_PUNCT     0x20  // first char of a punctuator
+
+#define ISCHAR(c, class) (chartype[(unsigned char)(c)] & (class))
+
+extern const unsigned char chartype[256];
+
+#define TF_SPACE  1  // whitespace before the token
+#define TF_BOL    2  // first token of the text
+
+typedef struct pptoken {
+  tokenkind_t kind;
+  char *start;          // first char of the token in the text
+  int len;              // length of the token
+  unsigned char flags;  // TF_SPACE, TF_BOL
+} pptoken_t;
+
+char *lextoken(char *buf, char *end, pptoken_t *tok);
+char *lexfirst(char *buf, char *end, pptoken_t *tok);
+int tokenis(const pptoken_t *tok, const char *text);
+
+#endif  // TOKEN_H
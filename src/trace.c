@@ -0,0 +1,247 @@
+/**
+ * @file trace.c
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief timeline of includes, #if evaluations and expansions in trace event format
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The trace file is written in the JSON trace event format and can be
+ * loaded in chrome://tracing or Perfetto. Includes are recorded as nested
+ * begin/end spans, #if evaluations and macro expansions as complete events.
+ * Expansions are only recorded if they take at least trace_threshold ns.
+ *
+ * Events are collected in a per thread buffer and written to the file when
+ * the buffer is full and at trace_close(). Event names are copied to a name
+ * pool of the buffer, as the strings of the callers (file names, macros) may
+ * be released before the buffer is written.
+ */
+#define NDEBUG
+#define DBG_SUBSYSTEM DBG_REPORT
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "debug.h"
+#include "trace.h"
+#include "alloc.h"
+
+#define TRACE_EVENTS  4096
+#define TRACE_NAMES   (64 * 1024)
+#define TRACE_NAMELEN 256
+
+
+typedef struct traceevent {
+  const char *cat;    /**< category, static string */
+  const char *name;   /**< name in the name pool, or NULL */
+  long long ts;       /**< timestamp in ns since trace_open() */
+  long long dur;      /**< duration in ns for complete events */
+  char ph;            /**< phase: 'B'egin, 'E'nd or 'X' complete */
+} traceevent_t;
+
+
+typedef struct tracebuf {
+  int count;
+  int namepos;
+  int tid;
+  traceevent_t events[TRACE_EVENTS];
+  char names[TRACE_NAMES];
+} tracebuf_t;
+
+
+int trace_enabled = 0;
+long long trace_threshold = 10000;
+
+static FILE *tracefile = NULL;
+static int tracecount = 0;
+static long long tracestart = 0;
+static int tracethreads = 0;
+static _Thread_local tracebuf_t *tracebuf = NULL;
+
+
+
+long long trace_now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec - tracestart;
+}
+
+
+
+static void writestring(const char *s)
+{
+  fputc('"', tracefile);
+  for (; *s != '\0'; s++) {
+    unsigned char c = *s;
+    if (c == '"' || c == '\\') {
+      fputc('\\', tracefile);
+      fputc(c, tracefile);
+    } else if (c < 0x20) {
+      fprintf(tracefile, "\\u%04x", c);
+    } else {
+      fputc(c, tracefile);
+    }
+  }
+  fputc('"', tracefile);
+}
+
+
+
+/**
+ * @brief writes all events of the buffer of the current thread to the trace file
+ */
+static void flush()
+{
+  tracebuf_t *tb = tracebuf;
+
+  for (int i = 0; i < tb->count; i++) {
+    traceevent_t *ev = &tb->events[i];
+    fprintf(tracefile, "%s\n{\"ph\":\"%c\",\"cat\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+            tracecount++ ? "," : "", ev->ph, ev->cat, tb->tid, ev->ts / 1000.0);
+    if (ev->ph == 'X') {
+      fprintf(tracefile, ",\"dur\":%.3f", ev->dur / 1000.0);
+    }
+    if (ev->name != NULL) {
+      fprintf(tracefile, ",\"name\":");
+      writestring(ev->name);
+    }
+    fputc('}', tracefile);
+  }
+  tb->count = 0;
+  tb->namepos = 0;
+}
+
+
+
+static traceevent_t *newevent(char ph, const char *cat, const char *name, int namelen)
+{
+  if (tracebuf == NULL) {
+    tracebuf = xmalloc(ALLOC_REPORT, sizeof(tracebuf_t));
+    if (tracebuf == NULL) {
+      DPRINTERR("newevent: out of memory, tracing disabled\n");
+      trace_enabled = 0;
+      return NULL;
+    }
+    tracebuf->count = 0;
+    tracebuf->namepos = 0;
+    tracebuf->tid = ++tracethreads;
+  }
+  if (namelen > TRACE_NAMELEN) {
+    namelen = TRACE_NAMELEN;
+  }
+  if (tracebuf->count >= TRACE_EVENTS || tracebuf->namepos + namelen + 1 > TRACE_NAMES) {
+    flush();
+  }
+
+  traceevent_t *ev = &tracebuf->events[tracebuf->count++];
+  ev->ph = ph;
+  ev->cat = cat;
+  ev->name = NULL;
+  ev->dur = 0;
+  if (name != NULL) {
+    char *p = tracebuf->names + tracebuf->namepos;
+    memcpy(p, name, namelen);
+    p[namelen] = '\0';
+    tracebuf->namepos += namelen + 1;
+    ev->name = p;
+  }
+  return ev;
+}
+
+
+
+/**
+ * @brief opens the trace file and enables tracing
+ *
+ * @param fname name of the trace file
+ * @return 0 on success, -1 if the file can not be opened
+ */
+int trace_open(const char *fname)
+{
+  tracefile = fopen(fname, "w");
+  if (tracefile == NULL) {
+    DPRINTERR("trace_open: can not open %s\n", fname);
+    perror(fname);
+    return -1;
+  }
+  tracestart = 0;
+  tracestart = trace_now();
+  fprintf(tracefile, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  trace_enabled = 1;
+  return 0;
+}
+
+
+
+/**
+ * @brief writes the remaining events and closes the trace file
+ */
+void trace_close()
+{
+  if (tracefile == NULL) {
+    return;
+  }
+  if (tracebuf != NULL) {
+    flush();
+    xfree(ALLOC_REPORT, tracebuf);
+    tracebuf = NULL;
+  }
+  fprintf(tracefile, "\n]}\n");
+  fclose(tracefile);
+  tracefile = NULL;
+  trace_enabled = 0;
+}
+
+
+
+/**
+ * @brief begins a span, spans of one category have to be properly nested
+ *
+ * @param cat category of the span
+ * @param name name of the span
+ */
+void trace_begin(const char *cat, const char *name)
+{
+  traceevent_t *ev = newevent('B', cat, name, strlen(name));
+  if (ev != NULL) {
+    ev->ts = trace_now();
+  }
+}
+
+
+
+/**
+ * @brief ends the innermost span
+ *
+ * @param cat category of the span
+ */
+void trace_end(const char *cat)
+{
+  traceevent_t *ev = newevent('E', cat, NULL, 0);
+  if (ev != NULL) {
+    ev->ts = trace_now();
+  }
+}
+
+
+
+/**
+ * @brief records a complete event from start until now
+ *
+ * @param cat category of the event
+ * @param name name of the event, does not need to be terminated
+ * @param namelen length of the name
+ * @param start timestamp of the begin, taken with trace_now()
+ */
+void trace_complete(const char *cat, const char *name, int namelen, long long start)
+{
+  long long now = trace_now();
+  traceevent_t *ev = newevent('X', cat, name, namelen);
+  if (ev != NULL) {
+    ev->ts = start;
+    ev->dur = now - start;
+  }
+}
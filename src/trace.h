@@ -0,0 +1,25 @@
+/**
+ * @file trace.h
+ * @author Thomas Boos (tboos70@gmail.com)
+ * @brief timeline of includes, #if evaluations and expansions in trace event format
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+extern int trace_enabled;
+extern long long trace_threshold;
+
+int trace_open(const char *fname);
+void trace_close();
+long long trace_now();
+void trace_begin(const char *cat, const char *name);
+void trace_end(const char *cat);
+void trace_complete(const char *cat, const char *name, int namelen, long long start);
+
+#endif  // TRACE_H
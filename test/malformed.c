@@ -0,0 +1,3 @@
+#define MALFORMED(x) x
+#define MALFORMED(x y) x
+MALFORMED(1)
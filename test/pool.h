@@ -0,0 +1,495 @@
+// Identical redefinitions of a functional macro, then a differing one, which
+// compacts the pool. The rollback of the identical ones must not leave the
+// bytes saved by parsing their parameters counted as unused.
+#define POOL_LONG_0 pool_value_0_0 + pool_value_0_1 + pool_value_0_2 + pool_value_0_3 + pool_value_0_4 + pool_value_0_5 + pool_value_0_6 + pool_value_0_7 + pool_value_0_8 + pool_value_0_9 + pool_value_0_10 + pool_value_0_11
+#define POOL_LONG_1 pool_value_1_0 + pool_value_1_1 + pool_value_1_2 + pool_value_1_3 + pool_value_1_4 + pool_value_1_5 + pool_value_1_6 + pool_value_1_7 + pool_value_1_8 + pool_value_1_9 + pool_value_1_10 + pool_value_1_11
+#define POOL_LONG_2 pool_value_2_0 + pool_value_2_1 + pool_value_2_2 + pool_value_2_3 + pool_value_2_4 + pool_value_2_5 + pool_value_2_6 + pool_value_2_7 + pool_value_2_8 + pool_value_2_9 + pool_value_2_10 + pool_value_2_11
+#define POOL_LONG_3 pool_value_3_0 + pool_value_3_1 + pool_value_3_2 + pool_value_3_3 + pool_value_3_4 + pool_value_3_5 + pool_value_3_6 + pool_value_3_7 + pool_value_3_8 + pool_value_3_9 + pool_value_3_10 + pool_value_3_11
+#define POOL_LONG_4 pool_value_4_0 + pool_value_4_1 + pool_value_4_2 + pool_value_4_3 + pool_value_4_4 + pool_value_4_5 + pool_value_4_6 + pool_value_4_7 + pool_value_4_8 + pool_value_4_9 + pool_value_4_10 + pool_value_4_11
+#define POOL_LONG_5 pool_value_5_0 + pool_value_5_1 + pool_value_5_2 + pool_value_5_3 + pool_value_5_4 + pool_value_5_5 + pool_value_5_6 + pool_value_5_7 + pool_value_5_8 + pool_value_5_9 + pool_value_5_10 + pool_value_5_11
+#define POOL_LONG_6 pool_value_6_0 + pool_value_6_1 + pool_value_6_2 + pool_value_6_3 + pool_value_6_4 + pool_value_6_5 + pool_value_6_6 + pool_value_6_7 + pool_value_6_8 + pool_value_6_9 + pool_value_6_10 + pool_value_6_11
+#define POOL_LONG_7 pool_value_7_0 + pool_value_7_1 + pool_value_7_2 + pool_value_7_3 + pool_value_7_4 + pool_value_7_5 + pool_value_7_6 + pool_value_7_7 + pool_value_7_8 + pool_value_7_9 + pool_value_7_10 + pool_value_7_11
+#define POOL_LONG_8 pool_value_8_0 + pool_value_8_1 + pool_value_8_2 + pool_value_8_3 + pool_value_8_4 + pool_value_8_5 + pool_value_8_6 + pool_value_8_7 + pool_value_8_8 + pool_value_8_9 + pool_value_8_10 + pool_value_8_11
+#define POOL_LONG_9 pool_value_9_0 + pool_value_9_1 + pool_value_9_2 + pool_value_9_3 + pool_value_9_4 + pool_value_9_5 + pool_value_9_6 + pool_value_9_7 + pool_value_9_8 + pool_value_9_9 + pool_value_9_10 + pool_value_9_11
+#define POOL_LONG_10 pool_value_10_0 + pool_value_10_1 + pool_value_10_2 + pool_value_10_3 + pool_value_10_4 + pool_value_10_5 + pool_value_10_6 + pool_value_10_7 + pool_value_10_8 + pool_value_10_9 + pool_value_10_10 + pool_value_10_11
+#define POOL_LONG_11 pool_value_11_0 + pool_value_11_1 + pool_value_11_2 + pool_value_11_3 + pool_value_11_4 + pool_value_11_5 + pool_value_11_6 + pool_value_11_7 + pool_value_11_8 + pool_value_11_9 + pool_value_11_10 + pool_value_11_11
+#define POOL_LONG_12 pool_value_12_0 + pool_value_12_1 + pool_value_12_2 + pool_value_12_3 + pool_value_12_4 + pool_value_12_5 + pool_value_12_6 + pool_value_12_7 + pool_value_12_8 + pool_value_12_9 + pool_value_12_10 + pool_value_12_11
+#define POOL_LONG_13 pool_value_13_0 + pool_value_13_1 + pool_value_13_2 + pool_value_13_3 + pool_value_13_4 + pool_value_13_5 + pool_value_13_6 + pool_value_13_7 + pool_value_13_8 + pool_value_13_9 + pool_value_13_10 + pool_value_13_11
+#define POOL_LONG_14 pool_value_14_0 + pool_value_14_1 + pool_value_14_2 + pool_value_14_3 + pool_value_14_4 + pool_value_14_5 + pool_value_14_6 + pool_value_14_7 + pool_value_14_8 + pool_value_14_9 + pool_value_14_10 + pool_value_14_11
+#define POOL_LONG_15 pool_value_15_0 + pool_value_15_1 + pool_value_15_2 + pool_value_15_3 + pool_value_15_4 + pool_value_15_5 + pool_value_15_6 + pool_value_15_7 + pool_value_15_8 + pool_value_15_9 + pool_value_15_10 + pool_value_15_11
+#define POOL_LONG_16 pool_value_16_0 + pool_value_16_1 + pool_value_16_2 + pool_value_16_3 + pool_value_16_4 + pool_value_16_5 + pool_value_16_6 + pool_value_16_7 + pool_value_16_8 + pool_value_16_9 + pool_value_16_10 + pool_value_16_11
+#define POOL_LONG_17 pool_value_17_0 + pool_value_17_1 + pool_value_17_2 + pool_value_17_3 + pool_value_17_4 + pool_value_17_5 + pool_value_17_6 + pool_value_17_7 + pool_value_17_8 + pool_value_17_9 + pool_value_17_10 + pool_value_17_11
+#define POOL_LONG_18 pool_value_18_0 + pool_value_18_1 + pool_value_18_2 + pool_value_18_3 + pool_value_18_4 + pool_value_18_5 + pool_value_18_6 + pool_value_18_7 + pool_value_18_8 + pool_value_18_9 + pool_value_18_10 + pool_value_18_11
+#define POOL_LONG_19 pool_value_19_0 + pool_value_19_1 + pool_value_19_2 + pool_value_19_3 + pool_value_19_4 + pool_value_19_5 + pool_value_19_6 + pool_value_19_7 + pool_value_19_8 + pool_value_19_9 + pool_value_19_10 + pool_value_19_11
+#define POOL_LONG_20 pool_value_20_0 + pool_value_20_1 + pool_value_20_2 + pool_value_20_3 + pool_value_20_4 + pool_value_20_5 + pool_value_20_6 + pool_value_20_7 + pool_value_20_8 + pool_value_20_9 + pool_value_20_10 + pool_value_20_11
+#define POOL_LONG_21 pool_value_21_0 + pool_value_21_1 + pool_value_21_2 + pool_value_21_3 + pool_value_21_4 + pool_value_21_5 + pool_value_21_6 + pool_value_21_7 + pool_value_21_8 + pool_value_21_9 + pool_value_21_10 + pool_value_21_11
+#define POOL_LONG_22 pool_value_22_0 + pool_value_22_1 + pool_value_22_2 + pool_value_22_3 + pool_value_22_4 + pool_value_22_5 + pool_value_22_6 + pool_value_22_7 + pool_value_22_8 + pool_value_22_9 + pool_value_22_10 + pool_value_22_11
+#define POOL_LONG_23 pool_value_23_0 + pool_value_23_1 + pool_value_23_2 + pool_value_23_3 + pool_value_23_4 + pool_value_23_5 + pool_value_23_6 + pool_value_23_7 + pool_value_23_8 + pool_value_23_9 + pool_value_23_10 + pool_value_23_11
+#define POOL_LONG_24 pool_value_24_0 + pool_value_24_1 + pool_value_24_2 + pool_value_24_3 + pool_value_24_4 + pool_value_24_5 + pool_value_24_6 + pool_value_24_7 + pool_value_24_8 + pool_value_24_9 + pool_value_24_10 + pool_value_24_11
+#define POOL_LONG_25 pool_value_25_0 + pool_value_25_1 + pool_value_25_2 + pool_value_25_3 + pool_value_25_4 + pool_value_25_5 + pool_value_25_6 + pool_value_25_7 + pool_value_25_8 + pool_value_25_9 + pool_value_25_10 + pool_value_25_11
+#define POOL_LONG_26 pool_value_26_0 + pool_value_26_1 + pool_value_26_2 + pool_value_26_3 + pool_value_26_4 + pool_value_26_5 + pool_value_26_6 + pool_value_26_7 + pool_value_26_8 + pool_value_26_9 + pool_value_26_10 + pool_value_26_11
+#define POOL_LONG_27 pool_value_27_0 + pool_value_27_1 + pool_value_27_2 + pool_value_27_3 + pool_value_27_4 + pool_value_27_5 + pool_value_27_6 + pool_value_27_7 + pool_value_27_8 + pool_value_27_9 + pool_value_27_10 + pool_value_27_11
+#define POOL_LONG_28 pool_value_28_0 + pool_value_28_1 + pool_value_28_2 + pool_value_28_3 + pool_value_28_4 + pool_value_28_5 + pool_value_28_6 + pool_value_28_7 + pool_value_28_8 + pool_value_28_9 + pool_value_28_10 + pool_value_28_11
+#define POOL_LONG_29 pool_value_29_0 + pool_value_29_1 + pool_value_29_2 + pool_value_29_3 + pool_value_29_4 + pool_value_29_5 + pool_value_29_6 + pool_value_29_7 + pool_value_29_8 + pool_value_29_9 + pool_value_29_10 + pool_value_29_11
+#define POOL_LONG_30 pool_value_30_0 + pool_value_30_1 + pool_value_30_2 + pool_value_30_3 + pool_value_30_4 + pool_value_30_5 + pool_value_30_6 + pool_value_30_7 + pool_value_30_8 + pool_value_30_9 + pool_value_30_10 + pool_value_30_11
+#define POOL_LONG_31 pool_value_31_0 + pool_value_31_1 + pool_value_31_2 + pool_value_31_3 + pool_value_31_4 + pool_value_31_5 + pool_value_31_6 + pool_value_31_7 + pool_value_31_8 + pool_value_31_9 + pool_value_31_10 + pool_value_31_11
+#define POOL_LONG_32 pool_value_32_0 + pool_value_32_1 + pool_value_32_2 + pool_value_32_3 + pool_value_32_4 + pool_value_32_5 + pool_value_32_6 + pool_value_32_7 + pool_value_32_8 + pool_value_32_9 + pool_value_32_10 + pool_value_32_11
+#define POOL_LONG_33 pool_value_33_0 + pool_value_33_1 + pool_value_33_2 + pool_value_33_3 + pool_value_33_4 + pool_value_33_5 + pool_value_33_6 + pool_value_33_7 + pool_value_33_8 + pool_value_33_9 + pool_value_33_10 + pool_value_33_11
+#define POOL_LONG_34 pool_value_34_0 + pool_value_34_1 + pool_value_34_2 + pool_value_34_3 + pool_value_34_4 + pool_value_34_5 + pool_value_34_6 + pool_value_34_7 + pool_value_34_8 + pool_value_34_9 + pool_value_34_10 + pool_value_34_11
+#define POOL_LONG_35 pool_value_35_0 + pool_value_35_1 + pool_value_35_2 + pool_value_35_3 + pool_value_35_4 + pool_value_35_5 + pool_value_35_6 + pool_value_35_7 + pool_value_35_8 + pool_value_35_9 + pool_value_35_10 + pool_value_35_11
+#define POOL_LONG_36 pool_value_36_0 + pool_value_36_1 + pool_value_36_2 + pool_value_36_3 + pool_value_36_4 + pool_value_36_5 + pool_value_36_6 + pool_value_36_7 + pool_value_36_8 + pool_value_36_9 + pool_value_36_10 + pool_value_36_11
+#define POOL_LONG_37 pool_value_37_0 + pool_value_37_1 + pool_value_37_2 + pool_value_37_3 + pool_value_37_4 + pool_value_37_5 + pool_value_37_6 + pool_value_37_7 + pool_value_37_8 + pool_value_37_9 + pool_value_37_10 + pool_value_37_11
+#define POOL_LONG_38 pool_value_38_0 + pool_value_38_1 + pool_value_38_2 + pool_value_38_3 + pool_value_38_4 + pool_value_38_5 + pool_value_38_6 + pool_value_38_7 + pool_value_38_8 + pool_value_38_9 + pool_value_38_10 + pool_value_38_11
+#define POOL_LONG_39 pool_value_39_0 + pool_value_39_1 + pool_value_39_2 + pool_value_39_3 + pool_value_39_4 + pool_value_39_5 + pool_value_39_6 + pool_value_39_7 + pool_value_39_8 + pool_value_39_9 + pool_value_39_10 + pool_value_39_11
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_PARAMS(a, b, c, d, e, f, g, h, i, j) ((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h) + (i) + (j))
+#define POOL_G 1
+#define POOL_G 2
@@ -97,6 +97,127 @@ int main() {
   right(10);
 #ENDIF
 
+  // Test #elif chains
+#if LOCAL_MACRO_2 == 1
+  wrong(11);
+#elif HEADER_MACRO == 100
+  right(11);
+#elif 1
+  wrong(11);
+#else
+  wrong(11);
+#endif
+#if 1
+  right(12);
+#elif 1
+  wrong(12);
+#endif
+#if 0
+#elif 0
+  wrong(13);
+#else
+  right(13);
+#endif
+
+  // Test variadic macros and __VA_OPT__
+#define VA_PRINT(fmt, ...) printf(fmt, __VA_ARGS__)
+#define VA_ONLY(...) f(__VA_ARGS__)
+#define VA_OPT(fmt, ...) printf(fmt __VA_OPT__(,) __VA_ARGS__)
+  VA_PRINT("%d %d", 1, 2);
+  VA_ONLY();
+  VA_ONLY(a, (b, c), d);
+  VA_OPT("none");
+  VA_OPT("one %d", 1);
+#define EMPTY
+  VA_OPT("empty", EMPTY);
+
+  // Test invocations with the arguments on the next lines
+  VA_ONLY(first, VA_PRINT("%d",
+          1),
+#ifdef EMPTY
+          defined
+#else
+          undefined
+#endif
+          ); after(VA_ONLY(
+    last));
+
+  // Test # and ##
+#define STR(x) #x
+#define XSTR(x) STR(x)
+#define CAT(a, b) a ## b
+#define PASTE_OBJ var ## 2
+  PASTE_OBJ;
+  STR(a  "b\n"  'c');
+  XSTR(HEADER_MACRO);
+  CAT(var, 1) = CAT(, 2) + CAT(3, );
+  CAT(CAT, (x, y));
+
+  // Test the tokens at expansion boundaries, they must not merge
+#define ID(x) x
+#define NEG(x) -x
+  ID(a)ID(b) NEG(-1) -NEG(1) -EMPTY- CAT(1, e)+1 CAT(a, )CAT(, b);
+
+  // Test the builtin macros
+  __FILE__ __LINE__ __COUNTER__ __COUNTER__;
+#if defined(__DATE__) && defined(__TIME__)
+  right(14);
+#endif
+
+  // Test redefinitions, only the different one is reported
+#define REDEF (1 + 2)
+#define REDEF  (1  +  2)
+#define REDEF (1+2)
+  REDEF;
+#define PASTE_REDEF a ## b
+#define PASTE_REDEF ab
+  PASTE_REDEF;
+
+  // Test the memoized expansions after a dependency changes
+#define MEMO_A (MEMO_B + 1)
+#define MEMO_B 1
+  MEMO_A;
+#undef MEMO_B
+#define MEMO_B 2
+  MEMO_A;
+#undef MEMO_B
+  MEMO_A;
+#define MEMO_F(x) [x]
+#define MEMO_G MEMO_F
+  MEMO_G;
+  MEMO_G(1);
+
+  // Test the pool compaction after dropped redefinitions
+#include "pool.h"
+  POOL_G POOL_LONG_39 POOL_PARAMS(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+
+  // Test a header without include guard, which starts with an #ifndef
+#define TWICE_NAME twice_first
+#include "twice.h"
+#undef TWICE_NAME
+#define TWICE_NAME twice_second
+#include "twice.h"
+
+  // Test partial preprocessing, see the unifdef run of make test
+#if UNIFDEF_ON && UNIFDEF_UNKNOWN
+  unifdef(1);
+#elif UNIFDEF_OFF
+  unifdef(2);
+#else
+  unifdef(3);
+#endif
+#ifdef UNIFDEF_OFF
+  unifdef(4);
+#elif defined(UNIFDEF_UNKNOWN) || UNIFDEF_ON
+  unifdef(5);
+#endif
+#if UNIFDEF_OFF || UNIFDEF_ON > 0
+  unifdef(6);
+#endif
+#if UNIFDEF_BARE == 1 && UNIFDEF_ON == 2
+  unifdef(7);
+#endif
+
 
   return 0;
 }
@@ -0,0 +1,8 @@
+// Included twice with another TWICE_NAME. The #ifndef of the first line is
+// closed before the end of the file, so it is no include guard.
+#ifndef TWICE_NAME
+#define TWICE_NAME twice_default
+#endif
+#if 1
+  int TWICE_NAME;
+#endif